@@ -108,6 +108,7 @@ void DismantleFacilityState::btnOkClick(Action *)
 			if (*i == _fac)
 			{
 				_base->getFacilities()->erase(i);
+				_base->invalidateFacilities();
 				_view->resetSelectedFacility();
 				delete _fac;
 				if (Options::allowBuildingQueue) _view->reCalcQueuedBuildings();
@@ -88,6 +88,7 @@ void PlaceLiftState::viewClick(Action *)
 	fac->setX(_view->getGridX());
 	fac->setY(_view->getGridY());
 	_base->getFacilities()->push_back(fac);
+	_base->invalidateFacilities();
 	_game->popState();
 	BasescapeState *bState = new BasescapeState(_base, _globe);
 	_game->getSavedGame()->setSelectedBase(_game->getSavedGame()->getBases()->size() - 1);
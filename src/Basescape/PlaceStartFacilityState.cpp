@@ -71,6 +71,7 @@ void PlaceStartFacilityState::viewClick(Action *)
 		fac->setX(_view->getGridX());
 		fac->setY(_view->getGridY());
 		_base->getFacilities()->push_back(fac);
+		_base->invalidateFacilities();
 		_game->popState();
 		_select->facilityBuilt();
 	}
@@ -371,7 +371,7 @@ void PurchaseState::btnOkClick(Action *)
 				{
 					RuleItem *rule = (RuleItem*)i->rule;
 					t = new Transfer(rule->getTransferTime());
-					t->setItems(rule->getType(), i->amount);
+					t->setItems(rule, i->amount);
 					_base->getTransfers()->push_back(t);
 				}
 				break;
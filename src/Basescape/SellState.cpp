@@ -428,7 +428,7 @@ void SellState::btnOkClick(Action *)
 							}
 							else
 							{
-								(*j)->setItems((*j)->getItems(), (*j)->getQuantity() - toRemove);
+								(*j)->setItems((*j)->getItemRules(), (*j)->getQuantity() - toRemove);
 								toRemove = 0;
 							}
 						}
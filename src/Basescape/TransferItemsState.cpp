@@ -417,7 +417,7 @@ void TransferItemsState::completeTransfer()
 			case TRANSFER_ITEM:
 				_baseFrom->getStorageItems()->removeItem(((RuleItem*)i->rule)->getType(), i->amount);
 				t = new Transfer(time);
-				t->setItems(((RuleItem*)i->rule)->getType(), i->amount);
+				t->setItems((RuleItem*)i->rule, i->amount);
 				_baseTo->getTransfers()->push_back(t);
 				break;
 			}
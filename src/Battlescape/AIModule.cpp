@@ -48,7 +48,8 @@ namespace OpenXcom
  */
 AIModule::AIModule(SavedBattleGame *save, BattleUnit *unit, Node *node) : _save(save), _unit(unit), _aggroTarget(0), _knownEnemies(0), _visibleEnemies(0), _spottingEnemies(0),
 																				_escapeTUs(0), _ambushTUs(0), _rifle(false), _melee(false), _blaster(false),
-																				_didPsi(false), _AIMode(AI_PATROL), _closestDist(100), _fromNode(node), _toNode(0)
+																				_didPsi(false), _AIMode(AI_PATROL), _closestDist(100), _fromNode(node), _toNode(0),
+																				_exposureRevision(0)
 {
 	_traceAI = Options::traceAI;
 
@@ -136,6 +137,7 @@ YAML::Node AIModule::save() const
  */
 void AIModule::think(BattleAction *action)
 {
+	RNG::StreamScope stream(RNG::STREAM_AI);
 	action->type = BA_RETHINK;
 	action->actor = _unit;
 	action->weapon = _unit->getMainHandWeapon(false);
@@ -150,7 +152,7 @@ void AIModule::think(BattleAction *action)
 	_melee = (_unit->getMeleeWeapon() != 0);
 	_rifle = false;
 	_blaster = false;
-	_reachable = _save->getPathfinding()->findReachable(_unit, _unit->getTimeUnits());
+	_reachable = findReachable(_unit->getTimeUnits());
 	_wasHitBy.clear();
 
 	if (_unit->getCharging() && _unit->getCharging()->isOut())
@@ -197,18 +199,18 @@ void AIModule::think(BattleAction *action)
 				if (rule->getWaypoints() != 0 || (action->weapon->getAmmoItem() && action->weapon->getAmmoItem()->getRules()->getWaypoints() != 0))
 				{
 					_blaster = true;
-					_reachableWithAttack = _save->getPathfinding()->findReachable(_unit, _unit->getTimeUnits() - _unit->getActionTUs(BA_AIMEDSHOT, action->weapon));
+					_reachableWithAttack = findReachable(_unit->getTimeUnits() - _unit->getActionTUs(BA_AIMEDSHOT, action->weapon));
 				}
 				else
 				{
 					_rifle = true;
-					_reachableWithAttack = _save->getPathfinding()->findReachable(_unit, _unit->getTimeUnits() - _unit->getActionTUs(BA_SNAPSHOT, action->weapon));
+					_reachableWithAttack = findReachable(_unit->getTimeUnits() - _unit->getActionTUs(BA_SNAPSHOT, action->weapon));
 				}
 			}
 			else if (rule->getBattleType() == BT_MELEE)
 			{
 				_melee = true;
-				_reachableWithAttack = _save->getPathfinding()->findReachable(_unit, _unit->getTimeUnits() - _unit->getActionTUs(BA_HIT, action->weapon));
+				_reachableWithAttack = findReachable(_unit->getTimeUnits() - _unit->getActionTUs(BA_HIT, action->weapon));
 			}
 		}
 		else
@@ -1003,42 +1005,80 @@ int AIModule::countKnownTargets() const
 
 /*
  * counts how many enemies (xcom only) are spotting any given position.
+ * The counts are kept in a per-tile exposure layer, so the escape, ambush
+ * and fire point searches only trace lines for tiles they haven't asked about yet.
  * @param pos the Position to check for spotters.
  * @return spotters.
  */
 int AIModule::getSpottingUnits(const Position& pos) const
 {
+	Tile *posTile = _save->getTile(pos);
+	updateExposure();
+	int index = posTile ? _save->getTileIndex(pos) : -1;
+	if (index != -1 && _exposure[index] != -1)
+	{
+		return _exposure[index];
+	}
+
 	// if we don't actually occupy the position being checked, we need to do a virtual LOF check.
 	bool checking = pos != _unit->getPosition();
 	int tally = 0;
-	for (std::vector<BattleUnit*>::const_iterator i = _save->getUnits()->begin(); i != _save->getUnits()->end(); ++i)
+	for (std::vector<BattleUnit*>::const_iterator i = _exposureSpotters.begin(); i != _exposureSpotters.end(); ++i)
 	{
-		if (validTarget(*i, false, false))
+		int dist = _save->getTileEngine()->distance(pos, (*i)->getPosition());
+		if (dist > 20) continue;
+		Position originVoxel = _save->getTileEngine()->getSightOriginVoxel(*i);
+		originVoxel.z -= 2;
+		Position targetVoxel;
+		if (checking)
 		{
-			int dist = _save->getTileEngine()->distance(pos, (*i)->getPosition());
-			if (dist > 20) continue;
-			Position originVoxel = _save->getTileEngine()->getSightOriginVoxel(*i);
-			originVoxel.z -= 2;
-			Position targetVoxel;
-			if (checking)
+			if (_save->getTileEngine()->canTargetUnit(&originVoxel, posTile, &targetVoxel, *i, false, _unit))
 			{
-				if (_save->getTileEngine()->canTargetUnit(&originVoxel, _save->getTile(pos), &targetVoxel, *i, false, _unit))
-				{
-					tally++;
-				}
+				tally++;
 			}
-			else
+		}
+		else
+		{
+			if (_save->getTileEngine()->canTargetUnit(&originVoxel, posTile, &targetVoxel, *i, false))
 			{
-				if (_save->getTileEngine()->canTargetUnit(&originVoxel, _save->getTile(pos), &targetVoxel, *i, false))
-				{
-					tally++;
-				}
+				tally++;
 			}
 		}
 	}
+	if (index != -1)
+	{
+		_exposure[index] = tally;
+	}
 	return tally;
 }
 
+/**
+ * Makes sure the exposure layer still describes the battle: it is thrown away
+ * when anything on the map changed, when this unit moved (the virtual line
+ * of fire checks depend on where it stands) or when the set of known enemies changed.
+ */
+void AIModule::updateExposure() const
+{
+	std::vector<BattleUnit*> spotters;
+	for (std::vector<BattleUnit*>::const_iterator i = _save->getUnits()->begin(); i != _save->getUnits()->end(); ++i)
+	{
+		if (validTarget(*i, false, false))
+		{
+			spotters.push_back(*i);
+		}
+	}
+	if (_exposure.size() != (size_t)_save->getMapSizeXYZ() ||
+		_exposureRevision != Tile::getGeometryRevision() ||
+		_exposurePosition != _unit->getPosition() ||
+		_exposureSpotters != spotters)
+	{
+		_exposure.assign(_save->getMapSizeXYZ(), -1);
+		_exposureRevision = Tile::getGeometryRevision();
+		_exposurePosition = _unit->getPosition();
+		_exposureSpotters.swap(spotters);
+	}
+}
+
 /**
  * Selects the nearest known living target we can see/reach and returns the number of visible enemies.
  * This function includes civilians as viable targets.
@@ -2093,7 +2133,7 @@ void AIModule::selectMeleeOrRanged()
 		if (RNG::percent(meleeOdds))
 		{
 			_rifle = false;
-			_reachableWithAttack = _save->getPathfinding()->findReachable(_unit, _unit->getTimeUnits() - _unit->getActionTUs(BA_HIT, meleeWeapon));
+			_reachableWithAttack = findReachable(_unit->getTimeUnits() - _unit->getActionTUs(BA_HIT, meleeWeapon));
 			return;
 		}
 	}
@@ -2171,4 +2211,133 @@ void AIModule::freePatrolTarget()
 	}
 }
 
+/**
+ * Picks the TU budgets think() looks for reachable tiles with,
+ * given the unit's current TUs and weapons, so they can be planned ahead.
+ * Must run on the main thread.
+ */
+void AIModule::preparePlan()
+{
+	_planBudgets.clear();
+	_reachablePlans.clear();
+	int tu = _unit->getTimeUnits();
+	_planBudgets.push_back(tu);
+	BattleItem *weapon = _unit->getMainHandWeapon(false);
+	if (weapon && _save->isItemUsable(weapon))
+	{
+		RuleItem *rule = weapon->getRules();
+		if (rule->getBattleType() == BT_FIREARM)
+		{
+			if (rule->getWaypoints() != 0 || (weapon->getAmmoItem() && weapon->getAmmoItem()->getRules()->getWaypoints() != 0))
+			{
+				_planBudgets.push_back(tu - _unit->getActionTUs(BA_AIMEDSHOT, weapon));
+			}
+			else
+			{
+				_planBudgets.push_back(tu - _unit->getActionTUs(BA_SNAPSHOT, weapon));
+			}
+		}
+		else if (rule->getBattleType() == BT_MELEE)
+		{
+			_planBudgets.push_back(tu - _unit->getActionTUs(BA_HIT, weapon));
+		}
+	}
+	BattleItem *meleeWeapon = _unit->getMeleeWeapon();
+	if (meleeWeapon)
+	{
+		_planBudgets.push_back(tu - _unit->getActionTUs(BA_HIT, meleeWeapon));
+	}
+	std::sort(_planBudgets.begin(), _planBudgets.end());
+	_planBudgets.erase(std::unique(_planBudgets.begin(), _planBudgets.end()), _planBudgets.end());
+}
+
+/**
+ * Works out the reachable tiles for the budgets picked by preparePlan().
+ * Only reads the battlescape, so it can run on a worker thread
+ * with a pathfinder of its own while other units are planned.
+ * @param pathfinding Pathfinder owned by the calling thread.
+ */
+void AIModule::planReachable(Pathfinding *pathfinding)
+{
+	pathfinding->setUnit(_unit);
+	for (std::vector<int>::const_iterator i = _planBudgets.begin(); i != _planBudgets.end(); ++i)
+	{
+		ReachablePlan plan;
+		plan.origin = _unit->getPosition();
+		plan.tuMax = *i;
+		plan.energy = _unit->getEnergy();
+		plan.spotted = _unit->getUnitsSpottedThisTurn().size();
+		plan.movementType = pathfinding->getMovementType();
+		plan.revision = Tile::getGeometryRevision();
+		plan.tiles = pathfinding->findReachable(_unit, *i);
+		plan.minCorner = plan.maxCorner = plan.origin;
+		for (std::vector<int>::const_iterator j = plan.tiles.begin(); j != plan.tiles.end(); ++j)
+		{
+			Position pos;
+			_save->getTileCoords(*j, &pos.x, &pos.y, &pos.z);
+			plan.minCorner.x = std::min(plan.minCorner.x, pos.x);
+			plan.minCorner.y = std::min(plan.minCorner.y, pos.y);
+			plan.maxCorner.x = std::max(plan.maxCorner.x, pos.x);
+			plan.maxCorner.y = std::max(plan.maxCorner.y, pos.y);
+		}
+		_reachablePlans.push_back(plan);
+	}
+}
+
+/**
+ * Checks that no tile the search could have looked at changed since the plan
+ * was worked out. Moves look at most one tile past where they end, plus one
+ * more for large units, on any level.
+ * @param plan The plan to check.
+ * @return True if the plan still holds.
+ */
+bool AIModule::isPlanCurrent(const ReachablePlan &plan) const
+{
+	int margin = _unit->getArmor()->getSize() + 1;
+	int minX = std::max(0, plan.minCorner.x - margin), maxX = std::min(_save->getMapSizeX() - 1, plan.maxCorner.x + margin);
+	int minY = std::max(0, plan.minCorner.y - margin), maxY = std::min(_save->getMapSizeY() - 1, plan.maxCorner.y + margin);
+	for (int z = 0; z < _save->getMapSizeZ(); ++z)
+	{
+		for (int y = minY; y <= maxY; ++y)
+		{
+			for (int x = minX; x <= maxX; ++x)
+			{
+				if (_save->getTile(Position(x, y, z))->getLastChange() > plan.revision)
+				{
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * Gets the tiles reachable with a TU budget. Uses the tiles planned at the
+ * start of the turn when the unit, its pathfinding settings and the tiles
+ * around it are as they were then, as the search would find the same tiles.
+ * @param tuMax The maximum TU cost of the path to each tile.
+ * @return The reachable tiles, sorted in ascending order of cost.
+ */
+std::vector<int> AIModule::findReachable(int tuMax)
+{
+	Pathfinding *pathfinding = _save->getPathfinding();
+	if (!pathfinding->getStrafeMove())
+	{
+		for (std::vector<ReachablePlan>::const_iterator i = _reachablePlans.begin(); i != _reachablePlans.end(); ++i)
+		{
+			if (i->tuMax == tuMax &&
+				i->origin == _unit->getPosition() &&
+				i->energy == _unit->getEnergy() &&
+				i->spotted == _unit->getUnitsSpottedThisTurn().size() &&
+				i->movementType == pathfinding->getMovementType() &&
+				isPlanCurrent(*i))
+			{
+				return i->tiles;
+			}
+		}
+	}
+	return pathfinding->findReachable(_unit, tuMax);
+}
+
 }
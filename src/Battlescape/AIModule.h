@@ -32,6 +32,7 @@ class BattleUnit;
 struct BattleAction;
 class BattlescapeState;
 class Node;
+class Pathfinding;
 
 enum AIMode { AI_PATROL, AI_AMBUSH, AI_COMBAT, AI_ESCAPE };
 /**
@@ -53,6 +54,28 @@ private:
 	std::vector<int> _reachable, _reachableWithAttack, _wasHitBy;
 	BattleActionType _reserve;
 	UnitFaction _targetFaction;
+	/// Tiles reachable with a TU budget, worked out ahead of time, and the state they were worked out from.
+	struct ReachablePlan
+	{
+		Position origin, minCorner, maxCorner;
+		int tuMax, energy;
+		size_t spotted;
+		MovementType movementType;
+		unsigned int revision;
+		std::vector<int> tiles;
+	};
+	std::vector<int> _planBudgets;
+	std::vector<ReachablePlan> _reachablePlans;
+	mutable std::vector<short> _exposure;
+	mutable std::vector<BattleUnit*> _exposureSpotters;
+	mutable unsigned int _exposureRevision;
+	mutable Position _exposurePosition;
+	/// Resets the exposure layer if the battle changed since it was filled in.
+	void updateExposure() const;
+	/// Checks that nothing around a plan changed since it was worked out.
+	bool isPlanCurrent(const ReachablePlan &plan) const;
+	/// Gets the tiles reachable with a TU budget, from the turn plan if it still holds.
+	std::vector<int> findReachable(int tuMax);
 public:
 	/// Creates a new AIModule linked to the game and a certain unit.
 	AIModule(SavedBattleGame *save, BattleUnit *unit, Node *node);
@@ -121,6 +144,10 @@ public:
 	BattleUnit* getTarget();
 	/// Frees up the destination node for another Unit to select
 	void freePatrolTarget();
+	/// Picks the TU budgets think() will look for reachable tiles with.
+	void preparePlan();
+	/// Works out the reachable tiles for the prepared budgets.
+	void planReachable(Pathfinding *pathfinding);
 };
 
 }
@@ -17,6 +17,8 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <sstream>
+#include <atomic>
+#include <thread>
 #include "BattlescapeGame.h"
 #include "BattlescapeState.h"
 #include "Map.h"
@@ -61,6 +63,40 @@
 namespace OpenXcom
 {
 
+namespace
+{
+
+/// AI units waiting to be planned, shared by the planning threads.
+struct PlanQueue
+{
+	std::vector<AIModule*> modules;
+	std::atomic<size_t> next;
+};
+
+/// What a single planning thread works with.
+struct PlanWorker
+{
+	PlanQueue *queue;
+	Pathfinding *pathfinding;
+};
+
+/**
+ * Plans AI units off the shared queue until it runs out.
+ * @param worker_ptr Pointer to the PlanWorker of this thread.
+ * @return Always zero.
+ */
+int planUnits(void *worker_ptr)
+{
+	PlanWorker *worker = (PlanWorker*)worker_ptr;
+	for (size_t i = worker->queue->next++; i < worker->queue->modules.size(); i = worker->queue->next++)
+	{
+		worker->queue->modules[i]->planReachable(worker->pathfinding);
+	}
+	return 0;
+}
+
+}
+
 bool BattlescapeGame::_debugPlay = false;
 
 /**
@@ -68,7 +104,7 @@ bool BattlescapeGame::_debugPlay = false;
  * @param save Pointer to the save game.
  * @param parentState Pointer to the parent battlescape state.
  */
-BattlescapeGame::BattlescapeGame(SavedBattleGame *save, BattlescapeState *parentState) : _save(save), _parentState(parentState), _playerPanicHandled(true), _AIActionCounter(0), _AISecondMove(false), _playedAggroSound(false), _endTurnRequested(false), _endTurnProcessed(false)
+BattlescapeGame::BattlescapeGame(SavedBattleGame *save, BattlescapeState *parentState) : _save(save), _parentState(parentState), _playerPanicHandled(true), _AIActionCounter(0), _AISecondMove(false), _playedAggroSound(false), _endTurnRequested(false), _endTurnProcessed(false), _AIPlanned(false)
 {
 
 	_currentAction.actor = 0;
@@ -91,6 +127,10 @@ BattlescapeGame::~BattlescapeGame()
 	{
 		delete *i;
 	}
+	for (std::vector<Pathfinding*>::iterator i = _planners.begin(); i != _planners.end(); ++i)
+	{
+		delete *i;
+	}
 	cleanupDeleted();
 }
 
@@ -149,6 +189,60 @@ void BattlescapeGame::think()
 	}
 }
 
+/**
+ * Works out the reachable tiles of every AI unit of the side in play
+ * at the start of its turn, spread over one thread per core. The searches
+ * only read the battlescape, each thread has a pathfinder of its own and
+ * the main thread waits for them, so nothing else touches the map meanwhile.
+ * The units then think one after another as before, reusing their plan
+ * for as long as nothing around them changed.
+ */
+void BattlescapeGame::planAI()
+{
+	PlanQueue queue;
+	queue.next = 0;
+	for (std::vector<BattleUnit*>::iterator i = _save->getUnits()->begin(); i != _save->getUnits()->end(); ++i)
+	{
+		if ((*i)->getFaction() == _save->getSide() && (*i)->getFaction() != FACTION_PLAYER &&
+			!(*i)->isOut() && (*i)->getTile() && (*i)->getAIModule())
+		{
+			(*i)->getAIModule()->preparePlan();
+			queue.modules.push_back((*i)->getAIModule());
+		}
+	}
+	if (queue.modules.empty())
+	{
+		return;
+	}
+
+	size_t threads = std::min<size_t>(queue.modules.size(), std::max(1u, std::thread::hardware_concurrency()));
+	while (_planners.size() < threads)
+	{
+		_planners.push_back(new Pathfinding(_save));
+	}
+	std::vector<PlanWorker> workers(threads);
+	for (size_t i = 0; i < threads; ++i)
+	{
+		workers[i].queue = &queue;
+		workers[i].pathfinding = _planners[i];
+	}
+	// the main thread takes its share too, and picks up any work a thread failed to start for
+	std::vector<SDL_Thread*> running;
+	for (size_t i = 1; i < threads; ++i)
+	{
+		SDL_Thread *thread = SDL_CreateThread(planUnits, (void*)&workers[i]);
+		if (thread)
+		{
+			running.push_back(thread);
+		}
+	}
+	planUnits((void*)&workers[0]);
+	for (std::vector<SDL_Thread*>::iterator i = running.begin(); i != running.end(); ++i)
+	{
+		SDL_WaitThread(*i, 0);
+	}
+}
+
 /**
  * Initializes the Battlescape game.
  */
@@ -169,6 +263,12 @@ void BattlescapeGame::handleAI(BattleUnit *unit)
 {
 	std::ostringstream ss;
 
+	if (!_AIPlanned)
+	{
+		planAI();
+		_AIPlanned = true;
+	}
+
 	if (unit->getTimeUnits() <= 5)
 	{
 		unit->dontReselect();
@@ -361,6 +461,8 @@ void BattlescapeGame::endTurn()
 	_parentState->showLaunchButton(false);
 	_currentAction.targeting = false;
 	_AISecondMove = false;
+	_AIPlanned = false;
+	getTileEngine()->clearSightCache();
 
 	if (!_endTurnProcessed)
 	{
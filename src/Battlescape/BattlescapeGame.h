@@ -76,6 +76,8 @@ private:
 	BattleAction _currentAction;
 	bool _AISecondMove, _playedAggroSound;
 	bool _endTurnRequested, _endTurnProcessed;
+	bool _AIPlanned;
+	std::vector<Pathfinding*> _planners;
 
 	/// Ends the turn.
 	void endTurn();
@@ -88,6 +90,8 @@ private:
 	std::vector<InfoboxOKState*> _infoboxQueue;
 	/// Shows the infoboxes in the queue (if any).
 	void showInfoBoxQueue();
+	/// Plans ahead for all the AI units of the side in play.
+	void planAI();
 public:
 	/// is debug mode enabled in the battlescape?
 	static bool _debugPlay;
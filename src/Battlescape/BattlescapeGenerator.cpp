@@ -17,7 +17,6 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <assert.h>
-#include <fstream>
 #include <sstream>
 #include "BattlescapeGenerator.h"
 #include "TileEngine.h"
@@ -40,7 +39,6 @@
 #include "../Savegame/AlienBase.h"
 #include "../Savegame/EquipmentLayoutItem.h"
 #include "../Engine/Game.h"
-#include "../Engine/FileMap.h"
 #include "../Engine/Options.h"
 #include "../Engine/RNG.h"
 #include "../Engine/Exception.h"
@@ -68,9 +66,10 @@ static bool _addItem(BattleItem *item, BattleUnit *unit, Mod *mod, SavedBattleGa
 /**
  * Sets up a BattlescapeGenerator.
  * @param game pointer to Game object.
+ * @param save pointer to the battle to generate, defaults to the current one.
  */
-BattlescapeGenerator::BattlescapeGenerator(Game *game) : _game(game), _save(game->getSavedGame()->getSavedBattle()), _mod(game->getMod()), _craft(0), _ufo(0), _base(0), _mission(0), _alienBase(0), _terrain(0), _mapsize_x(0), _mapsize_y(0), _mapsize_z(0),
-														 _worldTexture(0), _worldShade(0), _unitSequence(0), _craftInventoryTile(0), _alienItemLevel(0), _baseInventory(false), _generateFuel(true), _craftDeployed(false), _craftZ(0), _blocksToDo(0), _dummy(0)
+BattlescapeGenerator::BattlescapeGenerator(Game *game, SavedBattleGame *save) : _game(game), _save(save ? save : game->getSavedGame()->getSavedBattle()), _mod(game->getMod()), _craft(0), _ufo(0), _base(0), _mission(0), _alienBase(0), _terrain(0), _mapsize_x(0), _mapsize_y(0), _mapsize_z(0),
+														 _worldTexture(0), _worldShade(0), _unitSequence(0), _craftInventoryTile(0), _alienItemLevel(0), _baseInventory(false), _generateFuel(true), _craftDeployed(false), _craftZ(0), _blocksToDo(0), _dummy(0), _progress(0)
 {
 	_allowAutoLoadout = !Options::disableAutoEquip;
 }
@@ -192,6 +191,7 @@ void BattlescapeGenerator::setMissionSite(MissionSite *mission)
  */
 void BattlescapeGenerator::nextStage()
 {
+	RNG::StreamScope stream(RNG::STREAM_MAPGEN);
 	RuleInventory *ground = _game->getMod()->getInventory("STR_GROUND", true);
 
 	// preventively drop all units from soldier's inventory (makes handling easier)
@@ -544,6 +544,7 @@ void BattlescapeGenerator::nextStage()
  */
 void BattlescapeGenerator::run()
 {
+	RNG::StreamScope stream(RNG::STREAM_MAPGEN);
 	AlienDeployment *ruleDeploy = _game->getMod()->getDeployment(_ufo?_ufo->getRules()->getType():_save->getMissionType(), true);
 
 	_save->setTurnLimit(ruleDeploy->getTurnLimit());
@@ -586,6 +587,7 @@ void BattlescapeGenerator::run()
 	{
 		_worldShade = ruleDeploy->getShade();
 	}
+	reportProgress(5);
 
 	const std::vector<MapScript*> *script = _game->getMod()->getMapScript(_terrain->getScript());
 	if (_game->getMod()->getMapScript(ruleDeploy->getScript()))
@@ -606,10 +608,12 @@ void BattlescapeGenerator::run()
 	setupObjectives(ruleDeploy);
 
 	deployXCOM();
+	reportProgress(75);
 
 	size_t unitCount = _save->getUnits()->size();
 
 	deployAliens(ruleDeploy);
+	reportProgress(85);
 
 	if (unitCount == _save->getUnits()->size())
 	{
@@ -631,10 +635,12 @@ void BattlescapeGenerator::run()
 	setMusic(ruleDeploy, false);
 	// set shade (alien bases are a little darker, sites depend on worldshade)
 	_save->setGlobalShade(_worldShade);
+	reportProgress(90);
 
 	_save->getTileEngine()->calculateSunShading();
 	_save->getTileEngine()->calculateTerrainLighting();
 	_save->getTileEngine()->calculateUnitLighting();
+	reportProgress(100);
 }
 
 /**
@@ -1198,11 +1204,11 @@ BattleUnit *BattlescapeGenerator::addAlien(Unit *rules, int alienRank, bool outs
 
 	if (node && _save->setUnitPosition(unit, node->getPosition()))
 	{
-		unit->setAIModule(new AIModule(_game->getSavedGame()->getSavedBattle(), unit, node));
+		unit->setAIModule(new AIModule(_save, unit, node));
 		unit->setRankInt(alienRank);
 		unit->setSpecialWeapon(_save, _game->getMod());
 		int dir = _save->getTileEngine()->faceWindow(node->getPosition());
-		Position craft = _game->getSavedGame()->getSavedBattle()->getUnits()->at(0)->getPosition();
+		Position craft = _save->getUnits()->at(0)->getPosition();
 		if (_save->getTileEngine()->distance(node->getPosition(), craft) <= 20 && RNG::percent(20 * difficulty))
 			dir = unit->directionTo(craft);
 		if (dir != -1)
@@ -1219,11 +1225,11 @@ BattleUnit *BattlescapeGenerator::addAlien(Unit *rules, int alienRank, bool outs
 		// DEMIGOD DIFFICULTY: screw the player: spawn as many aliens as possible.
 		if (_game->getMod()->isDemigod() && placeUnitNearFriend(unit))
 		{
-			unit->setAIModule(new AIModule(_game->getSavedGame()->getSavedBattle(), unit, 0));
+			unit->setAIModule(new AIModule(_save, unit, 0));
 			unit->setRankInt(alienRank);
 			unit->setSpecialWeapon(_save, _game->getMod());
 			int dir = _save->getTileEngine()->faceWindow(unit->getPosition());
-			Position craft = _game->getSavedGame()->getSavedBattle()->getUnits()->at(0)->getPosition();
+			Position craft = _save->getUnits()->at(0)->getPosition();
 			if (_save->getTileEngine()->distance(unit->getPosition(), craft) <= 20 && RNG::percent(20 * difficulty))
 				dir = unit->directionTo(craft);
 			if (dir != -1)
@@ -1561,23 +1567,12 @@ int BattlescapeGenerator::loadMAP(MapBlock *mapblock, int xoff, int yoff, RuleTe
 {
 	int sizex, sizey, sizez;
 	int x = xoff, y = yoff, z = 0;
-	char size[3];
-	unsigned char value[4];
 	std::ostringstream filename;
 	filename << "MAPS/" << mapblock->getName() << ".MAP";
 	unsigned int terrainObjectID;
 
-	// Load file
-	std::ifstream mapFile (FileMap::getFilePath(filename.str()).c_str(), std::ios::in| std::ios::binary);
-	if (!mapFile)
-	{
-		throw Exception(filename.str() + " not found");
-	}
-
-	mapFile.read((char*)&size, sizeof(size));
-	sizey = (int)size[0];
-	sizex = (int)size[1];
-	sizez = (int)size[2];
+	// the block keeps the file contents around, so this only hits the disk once
+	const std::vector<unsigned char> &records = mapblock->getMapRecords(&sizex, &sizey, &sizez);
 
 	mapblock->setSizeZ(sizez);
 
@@ -1623,8 +1618,9 @@ int BattlescapeGenerator::loadMAP(MapBlock *mapblock, int xoff, int yoff, RuleTe
 		throw Exception("Something is wrong in your map definitions, craft/ufo map is too tall?");
 	}
 
-	while (mapFile.read((char*)&value, sizeof(value)))
+	for (size_t r = 0; r < records.size(); r += 4)
 	{
+		const unsigned char *value = &records[r];
 		for (int part = O_FLOOR; part <= O_OBJECT; ++part)
 		{
 			terrainObjectID = ((unsigned char)value[part]);
@@ -1658,13 +1654,6 @@ int BattlescapeGenerator::loadMAP(MapBlock *mapblock, int xoff, int yoff, RuleTe
 		}
 	}
 
-	if (!mapFile.eof())
-	{
-		throw Exception("Invalid MAP file: " + filename.str());
-	}
-
-	mapFile.close();
-
 	if (_generateFuel)
 	{
 		// if one of the mapBlocks has an items array defined, don't deploy fuel algorithmically
@@ -1693,22 +1682,17 @@ int BattlescapeGenerator::loadMAP(MapBlock *mapblock, int xoff, int yoff, RuleTe
  */
 void BattlescapeGenerator::loadRMP(MapBlock *mapblock, int xoff, int yoff, int segment)
 {
-	unsigned char value[24];
 	std::ostringstream filename;
 	filename << "ROUTES/" << mapblock->getName() << ".RMP";
 
-	// Load file
-	std::ifstream mapFile (FileMap::getFilePath(filename.str()).c_str(), std::ios::in| std::ios::binary);
-	if (!mapFile)
-	{
-		throw Exception(filename.str() + " not found");
-	}
+	const std::vector<unsigned char> &records = mapblock->getRouteRecords();
 
 	size_t nodeOffset = _save->getNodes()->size();
 	std::vector<int> badNodes;
 	int nodesAdded = 0;
-	while (mapFile.read((char*)&value, sizeof(value)))
+	for (size_t r = 0; r < records.size(); r += 24)
 	{
+		const unsigned char *value = &records[r];
 		int pos_x = value[1];
 		int pos_y = value[0];
 		int pos_z = value[2];
@@ -1776,12 +1760,6 @@ void BattlescapeGenerator::loadRMP(MapBlock *mapblock, int xoff, int yoff, int s
 		}
 	}
 
-	if (!mapFile.eof())
-	{
-		throw Exception("Invalid RMP file: " + filename.str());
-	}
-
-	mapFile.close();
 }
 
 /**
@@ -1948,6 +1926,7 @@ bool BattlescapeGenerator::placeUnitNearFriend(BattleUnit *unit)
  */
 void BattlescapeGenerator::runInventory(Craft *craft)
 {
+	RNG::StreamScope stream(RNG::STREAM_MAPGEN);
 	// we need to fake a map for soldier placement
 	_baseInventory = true;
 	_mapsize_x = 2;
@@ -2031,6 +2010,7 @@ void BattlescapeGenerator::generateMap(const std::vector<MapScript*> *script)
 		_save->getMapDataSets()->push_back(*i);
 		mapDataSetIDOffset++;
 	}
+	reportProgress(10);
 
 	RuleTerrain* ufoTerrain = 0;
 	// lets generate the map now and store it inside the tile objects
@@ -2045,6 +2025,7 @@ void BattlescapeGenerator::generateMap(const std::vector<MapScript*> *script)
 	for (std::vector<MapScript*>::const_iterator i = script->begin(); i != script->end(); ++i)
 	{
 		MapScript *command = *i;
+		reportProgress(10 + 50 * (i - script->begin()) / script->size());
 
 		if (command->getLabel() > 0 && conditionals.find(command->getLabel()) != conditionals.end())
 		{
@@ -2264,6 +2245,7 @@ void BattlescapeGenerator::generateMap(const std::vector<MapScript*> *script)
 		throw Exception("Map failed to fully generate.");
 	}
 
+	reportProgress(60);
 	loadNodes();
 
 	if (!ufoMaps.empty() && ufoTerrain)
@@ -2335,6 +2317,7 @@ void BattlescapeGenerator::generateMap(const std::vector<MapScript*> *script)
 	}
 
 	attachNodeLinks();
+	reportProgress(70);
 }
 
 /**
@@ -2980,6 +2963,28 @@ void BattlescapeGenerator::setTerrain(RuleTerrain *terrain)
 	_terrain = terrain;
 }
 
+/**
+ * Sets the counter the generator reports its progress to,
+ * so a loading screen can follow it from another thread.
+ * @param progress Pointer to the counter (in percent).
+ */
+void BattlescapeGenerator::setProgress(std::atomic<int> *progress)
+{
+	_progress = progress;
+}
+
+/**
+ * Reports how far along the generation is.
+ * @param percent Progress in percent.
+ */
+void BattlescapeGenerator::reportProgress(int percent)
+{
+	if (_progress)
+	{
+		*_progress = percent;
+	}
+}
+
 
 /**
  * Sets up the objectives for the map.
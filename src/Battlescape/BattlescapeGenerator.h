@@ -18,6 +18,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <vector>
+#include <atomic>
 #include "../Mod/RuleTerrain.h"
 #include "../Mod/MapScript.h"
 
@@ -75,6 +76,7 @@ private:
 	std::vector< std::vector<bool> > _landingzone;
 	std::vector< std::vector<int> > _segments, _drillMap;
 	MapBlock *_dummy;
+	std::atomic<int> *_progress;
 
 	/// sets the map size and associated vars
 	void init(bool resetTerrain);
@@ -136,9 +138,11 @@ private:
 	void setDepth(AlienDeployment* ruleDeploy, bool nextStage);
 	/// Sets the background music based on the terrain or the provided AlienDeployment rule.
 	void setMusic(AlienDeployment* ruleDeploy, bool nextStage);
+	/// Reports how far along the generation is.
+	void reportProgress(int percent);
 public:
 	/// Creates a new BattlescapeGenerator class
-	BattlescapeGenerator(Game* game);
+	BattlescapeGenerator(Game* game, SavedBattleGame *save = 0);
 	/// Cleans up the BattlescapeGenerator.
 	~BattlescapeGenerator();
 	/// Sets the XCom craft.
@@ -161,6 +165,8 @@ public:
 	void setAlienBase(AlienBase* base);
 	/// Sets the terrain.
 	void setTerrain(RuleTerrain *terrain);
+	/// Sets the counter to report the progress to.
+	void setProgress(std::atomic<int> *progress);
 	/// Runs the generator.
 	void run();
 	/// Sets up the next stage (for Cydonia/TFTD missions).
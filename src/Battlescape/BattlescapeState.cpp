@@ -49,6 +49,7 @@
 #include "../Engine/Logger.h"
 #include "../Engine/Timer.h"
 #include "../Engine/CrossPlatform.h"
+#include "../Engine/RNG.h"
 #include "../Interface/Cursor.h"
 #include "../Interface/Text.h"
 #include "../Interface/Bar.h"
@@ -491,6 +492,7 @@ BattlescapeState::~BattlescapeState()
  */
 void BattlescapeState::init()
 {
+	RNG::setStream(RNG::STREAM_COMBAT);
 	if (_save->getAmbientSound() != -1)
 	{
 		_game->getMod()->getSoundByDepth(_save->getDepth(), _save->getAmbientSound())->loop();
@@ -788,7 +790,8 @@ void BattlescapeState::mapClick(Action *action)
 	if (_save->getDebugMode())
 	{
 		std::ostringstream ss;
-		ss << "Clicked " << pos;
+		TileEngine *te = _save->getTileEngine();
+		ss << "Clicked " << pos << " sight cache " << te->getSightCacheHits() << "/" << te->getSightCacheHits() + te->getSightCacheMisses() << " hits, " << te->getSightCacheInvalidations() << " resets";
 		debug(ss.str());
 	}
 
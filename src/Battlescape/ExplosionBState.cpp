@@ -115,8 +115,8 @@ void ExplosionBState::init()
 			int lowerLimit = std::max(1, _power/5);
 			for (int i = 0; i < lowerLimit; i++)
 			{
-				int X = RNG::generate(-_power/2,_power/2);
-				int Y = RNG::generate(-_power/2,_power/2);
+				int X = RNG::getStream(RNG::STREAM_COSMETIC).generate(-_power/2,_power/2);
+				int Y = RNG::getStream(RNG::STREAM_COSMETIC).generate(-_power/2,_power/2);
 				Position p = _center;
 				p.x += X; p.y += Y;
 				Explosion *explosion = new Explosion(p, frame, frameDelay, true);
@@ -0,0 +1,156 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "GenerateBattleState.h"
+#include <sstream>
+#include "BattlescapeGenerator.h"
+#include "BriefingState.h"
+#include "../Engine/Game.h"
+#include "../Engine/Screen.h"
+#include "../Engine/Exception.h"
+#include "../Engine/Unicode.h"
+#include "../Engine/LocalizedText.h"
+#include "../Interface/Text.h"
+#include "../Savegame/SavedGame.h"
+#include "../Savegame/SavedBattleGame.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Initializes all the elements in the Generate Battle screen.
+ * The battle isn't attached to the saved game until it's finished,
+ * so nothing else can see it half-built.
+ * @param generator Pointer to the set up generator, the state takes ownership.
+ * @param battle Pointer to the battle to generate.
+ * @param craft Pointer to the craft in the mission.
+ * @param base Pointer to the base in the mission.
+ */
+GenerateBattleState::GenerateBattleState(BattlescapeGenerator *generator, SavedBattleGame *battle, Craft *craft, Base *base) :
+	_generator(generator), _battle(battle), _craft(craft), _base(base), _thread(0), _progress(0), _done(false), _lastProgress(-1)
+{
+	_screen = false;
+
+	// Create objects
+	_txtStatus = new Text(320, 17, 0, 92);
+
+	// Set palette
+	setPalette(_game->getScreen()->getPalette());
+
+	add(_txtStatus, "textLoad", "geoscape");
+
+	centerAllSurfaces();
+
+	// Set up objects
+	_txtStatus->setBig();
+	_txtStatus->setAlign(ALIGN_CENTER);
+	_txtStatus->setText(tr("STR_LOADING"));
+
+	_generator->setProgress(&_progress);
+}
+
+/**
+ * Waits for the generator in case the game is quit early.
+ */
+GenerateBattleState::~GenerateBattleState()
+{
+	if (_thread != 0)
+	{
+		SDL_WaitThread(_thread, 0);
+	}
+	delete _generator;
+	delete _battle;
+}
+
+/**
+ * Generates the battle on a separate thread, so the
+ * screen keeps updating on big maps.
+ * @param state_ptr Pointer to the state.
+ * @return Thread status, 0 = ok
+ */
+int GenerateBattleState::generate(void *state_ptr)
+{
+	GenerateBattleState *state = (GenerateBattleState*)state_ptr;
+	try
+	{
+		state->_generator->run();
+	}
+	catch (std::exception &e)
+	{
+		state->_error = e.what();
+	}
+	state->_done = true;
+	return 0;
+}
+
+/**
+ * Starts the generator.
+ */
+void GenerateBattleState::init()
+{
+	State::init();
+
+	if (_thread == 0 && !_done)
+	{
+		_thread = SDL_CreateThread(generate, (void*)this);
+		if (_thread == 0)
+		{
+			// If we can't create the thread, just generate it as usual
+			generate((void*)this);
+		}
+	}
+}
+
+/**
+ * Updates the progress and moves on to the briefing
+ * once the battle is ready.
+ */
+void GenerateBattleState::think()
+{
+	State::think();
+
+	if (!_done)
+	{
+		int progress = _progress;
+		if (progress != _lastProgress)
+		{
+			_lastProgress = progress;
+			std::ostringstream ss;
+			ss << tr("STR_LOADING") << " " << Unicode::formatPercentage(progress);
+			_txtStatus->setText(ss.str());
+		}
+		return;
+	}
+
+	if (_thread != 0)
+	{
+		SDL_WaitThread(_thread, 0);
+		_thread = 0;
+	}
+	if (!_error.empty())
+	{
+		throw Exception(_error);
+	}
+
+	_game->getSavedGame()->setBattleGame(_battle);
+	_battle = 0;
+	_game->popState();
+	_game->pushState(new BriefingState(_craft, _base));
+}
+
+}
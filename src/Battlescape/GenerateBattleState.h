@@ -0,0 +1,65 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../Engine/State.h"
+#include <string>
+#include <atomic>
+#include <SDL_thread.h>
+
+namespace OpenXcom
+{
+
+class Text;
+class BattlescapeGenerator;
+class SavedBattleGame;
+class Craft;
+class Base;
+
+/**
+ * Loading screen shown while a new battlescape
+ * is generated on a separate thread.
+ */
+class GenerateBattleState : public State
+{
+private:
+	Text *_txtStatus;
+	BattlescapeGenerator *_generator;
+	SavedBattleGame *_battle;
+	Craft *_craft;
+	Base *_base;
+	SDL_Thread *_thread;
+	std::atomic<int> _progress;
+	std::atomic<bool> _done;
+	std::string _error;
+	int _lastProgress;
+
+	/// Runs the generator.
+	static int generate(void *state_ptr);
+public:
+	/// Creates the Generate Battle state.
+	GenerateBattleState(BattlescapeGenerator *generator, SavedBattleGame *battle, Craft *craft = 0, Base *base = 0);
+	/// Cleans up the Generate Battle state.
+	~GenerateBattleState();
+	/// Starts the generator.
+	void init();
+	/// Shows the progress and hands over the finished battle.
+	void think();
+};
+
+}
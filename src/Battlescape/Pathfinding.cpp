@@ -38,7 +38,7 @@ int Pathfinding::green = 4;
  * Sets up a Pathfinding.
  * @param save pointer to SavedBattleGame object.
  */
-Pathfinding::Pathfinding(SavedBattleGame *save) : _save(save), _unit(0), _pathPreviewed(false), _strafeMove(false), _totalTUCost(0), _modifierUsed(false), _movementType(MT_WALK)
+Pathfinding::Pathfinding(SavedBattleGame *save) : _save(save), _unit(0), _pathPreviewed(false), _strafeMove(false), _totalTUCost(0), _modifierUsed(false), _movementType(MT_WALK), _ignoreUnits(false)
 {
 	_size = _save->getMapSizeXYZ();
 	// Initialize one node per tile
@@ -161,6 +161,13 @@ void Pathfinding::calculate(BattleUnit *unit, Position endPosition, BattleUnit *
 	_strafeMove = Options::strafe && (SDL_GetModState() & KMOD_CTRL) != 0 && (startPosition.z == endPosition.z) &&
 							(abs(startPosition.x - endPosition.x) <= 1) && (abs(startPosition.y - endPosition.y) <= 1);
 
+	// don't search the whole map tile by tile for a destination that can't be reached from here
+	if (size == 0 && !isConnected(startPosition, endPosition, unit))
+	{
+		abortPath();
+		return;
+	}
+
 	// look for a possible fast and accurate bresenham path and skip A*
 	if (startPosition.z == endPosition.z && bresenhamPath(startPosition,endPosition, target, sneak))
 	{
@@ -331,7 +338,7 @@ int Pathfinding::getTUCost(Position startPosition, int direction, Position *endP
 						fellDown = true;
 					}
 			}
-			else if (!missile && _movementType == MT_FLY && belowDestination && belowDestination->getUnit() && belowDestination->getUnit() != unit)
+			else if (!missile && !_ignoreUnits && _movementType == MT_FLY && belowDestination && belowDestination->getUnit() && belowDestination->getUnit() != unit)
 			{
 				// 2 or more voxels poking into this tile = no go
 				if (belowDestination->getUnit()->getHeight() + belowDestination->getUnit()->getFloatHeight() - belowDestination->getTerrainLevel() > 26)
@@ -673,7 +680,7 @@ bool Pathfinding::isBlocked(Tile *tile, const int part, BattleUnit *missileTarge
 			 tileNorth->getMapData(O_OBJECT)->getBigWall() == BIGWALLEASTANDSOUTH))
 			return true; // blocking part
 	}
-	if (part == O_FLOOR)
+	if (part == O_FLOOR && !_ignoreUnits)
 	{
 		if (tile->getUnit())
 		{
@@ -1305,6 +1312,183 @@ bool Pathfinding::isModifierUsed() const
 	return _modifierUsed;
 }
 
+/**
+ * Finds the representative of the region a tile belongs to.
+ * @param parents Union-find parents of every tile.
+ * @param index Index of the tile.
+ * @return Index of the representative tile.
+ */
+int Pathfinding::findRegion(std::vector<int> &parents, int index)
+{
+	int root = index;
+	while (parents[root] != root)
+	{
+		root = parents[root];
+	}
+	while (parents[index] != root)
+	{
+		int next = parents[index];
+		parents[index] = root;
+		index = next;
+	}
+	return root;
+}
+
+/**
+ * Joins the regions two tiles belong to.
+ * @param parents Union-find parents of every tile.
+ * @param a Index of the first tile.
+ * @param b Index of the second tile.
+ */
+void Pathfinding::joinRegions(std::vector<int> &parents, int a, int b)
+{
+	a = findRegion(parents, a);
+	b = findRegion(parents, b);
+	if (a != b)
+	{
+		parents[std::max(a, b)] = std::min(a, b);
+	}
+}
+
+/**
+ * Works out which tiles of a map block are connected by moves inside it,
+ * and which moves cross into the blocks around it.
+ * @param layer Layer to update.
+ * @param clusterX X of the block.
+ * @param clusterY Y of the block.
+ * @param unit Unit the moves are checked for.
+ */
+void Pathfinding::buildCluster(ClusterLayer &layer, int clusterX, int clusterY, BattleUnit *unit)
+{
+	int clustersX = (_save->getMapSizeX() + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+	std::vector<std::pair<int, int> > &links = layer.links[clusterY * clustersX + clusterX];
+	links.clear();
+	int minX = clusterX * CLUSTER_SIZE, maxX = std::min(minX + CLUSTER_SIZE, _save->getMapSizeX());
+	int minY = clusterY * CLUSTER_SIZE, maxY = std::min(minY + CLUSTER_SIZE, _save->getMapSizeY());
+
+	for (int z = 0; z < _save->getMapSizeZ(); ++z)
+		for (int y = minY; y < maxY; ++y)
+			for (int x = minX; x < maxX; ++x)
+			{
+				int index = _save->getTileIndex(Position(x, y, z));
+				layer.regions[index] = index;
+			}
+
+	for (int z = 0; z < _save->getMapSizeZ(); ++z)
+		for (int y = minY; y < maxY; ++y)
+			for (int x = minX; x < maxX; ++x)
+			{
+				Position pos(x, y, z);
+				int index = _save->getTileIndex(pos);
+				for (int direction = 0; direction < 10; ++direction)
+				{
+					Position nextPos;
+					if (getTUCost(pos, direction, &nextPos, unit, 0, false) >= 255 || !_save->getTile(nextPos))
+						continue;
+					int nextIndex = _save->getTileIndex(nextPos);
+					if (nextPos.x >= minX && nextPos.x < maxX && nextPos.y >= minY && nextPos.y < maxY)
+					{
+						joinRegions(layer.regions, index, nextIndex);
+					}
+					else
+					{
+						links.push_back(std::make_pair(index, nextIndex));
+					}
+				}
+			}
+
+	for (int z = 0; z < _save->getMapSizeZ(); ++z)
+		for (int y = minY; y < maxY; ++y)
+			for (int x = minX; x < maxX; ++x)
+			{
+				int index = _save->getTileIndex(Position(x, y, z));
+				layer.regions[index] = findRegion(layer.regions, index);
+			}
+}
+
+/**
+ * Brings a block layer up to date: builds it the first time, and afterwards
+ * only rebuilds the blocks around tiles whose terrain changed, since moves
+ * never look further than the next tile. Then joins the regions of all
+ * blocks through the moves crossing their borders.
+ * @param layer Layer to update.
+ * @param unit Unit the moves are checked for.
+ */
+void Pathfinding::updateClusters(ClusterLayer &layer, BattleUnit *unit)
+{
+	int clustersX = (_save->getMapSizeX() + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+	int clustersY = (_save->getMapSizeY() + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+	std::vector<bool> dirty(clustersX * clustersY, false);
+	if (layer.regions.empty())
+	{
+		layer.regions.resize(_size);
+		layer.links.resize(clustersX * clustersY);
+		dirty.assign(dirty.size(), true);
+	}
+	else if (layer.revision != Tile::getTerrainRevision())
+	{
+		Tile **tiles = _save->getTiles();
+		for (int i = 0; i < _size; ++i)
+		{
+			if (tiles[i]->getLastTerrainChange() > layer.revision)
+			{
+				Position pos = tiles[i]->getPosition();
+				for (int y = std::max(0, pos.y - 1); y <= std::min(_save->getMapSizeY() - 1, pos.y + 1); ++y)
+					for (int x = std::max(0, pos.x - 1); x <= std::min(_save->getMapSizeX() - 1, pos.x + 1); ++x)
+						dirty[(y / CLUSTER_SIZE) * clustersX + x / CLUSTER_SIZE] = true;
+			}
+		}
+	}
+	else
+	{
+		return;
+	}
+	layer.revision = Tile::getTerrainRevision();
+
+	// units only ever block moves, so leaving them out keeps every path the real search could find
+	bool strafeMove = _strafeMove;
+	_strafeMove = false;
+	_ignoreUnits = true;
+	for (int y = 0; y < clustersY; ++y)
+		for (int x = 0; x < clustersX; ++x)
+			if (dirty[y * clustersX + x])
+				buildCluster(layer, x, y, unit);
+	_ignoreUnits = false;
+	_strafeMove = strafeMove;
+
+	layer.parents = layer.regions;
+	for (std::vector<std::vector<std::pair<int, int> > >::const_iterator i = layer.links.begin(); i != layer.links.end(); ++i)
+		for (std::vector<std::pair<int, int> >::const_iterator j = i->begin(); j != i->end(); ++j)
+			joinRegions(layer.parents, j->first, j->second);
+}
+
+/**
+ * Checks on the map block level whether the end position can be reached at all.
+ * The block layers ignore units and TU limits and join tiles regardless of the
+ * direction of the moves, so they only ever rule out paths that don't exist.
+ * @param startPosition The position to start from.
+ * @param endPosition The position we want to reach.
+ * @param unit Unit taking the path; must be a single tile unit.
+ * @return False if no path can exist.
+ */
+bool Pathfinding::isConnected(Position startPosition, Position endPosition, BattleUnit *unit)
+{
+	// up and down moves check the unit's own movement type, not the one of the search
+	ClusterLayer &layer = _clusterLayers[_movementType * 8 + unit->getMovementType()];
+	updateClusters(layer, unit);
+	return findRegion(layer.parents, _save->getTileIndex(startPosition)) == findRegion(layer.parents, _save->getTileIndex(endPosition));
+}
+
+/**
+ * Gets the movement type the TU costs are worked out for,
+ * as set by the last path calculation or setUnit().
+ * @return The movement type.
+ */
+MovementType Pathfinding::getMovementType() const
+{
+	return _movementType;
+}
+
 /**
  * Gets a reference to the current path.
  * @return the actual path.
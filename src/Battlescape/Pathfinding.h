@@ -18,6 +18,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <vector>
+#include <map>
 #include "Position.h"
 #include "PathfindingNode.h"
 #include "../Mod/MapData.h"
@@ -44,6 +45,26 @@ private:
 	int _totalTUCost;
 	bool _modifierUsed;
 	MovementType _movementType;
+	/// Connectivity of the map for one movement type, worked out per map block while ignoring units.
+	struct ClusterLayer
+	{
+		unsigned int revision;
+		std::vector<int> regions, parents;
+		std::vector<std::vector<std::pair<int, int> > > links;
+	};
+	static const int CLUSTER_SIZE = 10;
+	std::map<int, ClusterLayer> _clusterLayers;
+	bool _ignoreUnits;
+	/// Finds the representative of a region.
+	static int findRegion(std::vector<int> &parents, int index);
+	/// Joins the regions of two tiles.
+	static void joinRegions(std::vector<int> &parents, int a, int b);
+	/// Works out the regions and border links of one map block.
+	void buildCluster(ClusterLayer &layer, int clusterX, int clusterY, BattleUnit *unit);
+	/// Brings a block layer up to date with the terrain.
+	void updateClusters(ClusterLayer &layer, BattleUnit *unit);
+	/// Checks on the block level whether a path could exist at all.
+	bool isConnected(Position startPosition, Position endPosition, BattleUnit *unit);
 	/// Gets the node at certain position.
 	PathfindingNode *getNode(Position pos);
 	/// Determines whether a tile blocks a certain movementType.
@@ -105,6 +126,8 @@ public:
 	bool isPathPreviewed() const;
 	/// Gets the modifier setting.
 	bool isModifierUsed() const;
+	/// Gets the movement type costs are worked out for.
+	MovementType getMovementType() const;
 	/// Gets a reference to the path.
 	const std::vector<int> &getPath() const;
 	/// Makes a copy to the path.
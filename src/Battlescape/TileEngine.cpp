@@ -19,6 +19,7 @@
 #include <assert.h>
 #include <climits>
 #include <set>
+#include <algorithm>
 #include "TileEngine.h"
 #include <SDL.h>
 #include "AIModule.h"
@@ -53,7 +54,8 @@ const int TileEngine::heightFromCenter[11] = {0,-2,+2,-4,+4,-6,+6,-8,+8,-12,+12}
  * @param save Pointer to SavedBattleGame object.
  * @param voxelData List of voxel data.
  */
-TileEngine::TileEngine(SavedBattleGame *save, std::vector<Uint16> *voxelData) : _save(save), _voxelData(voxelData), _personalLighting(true), _cacheTile(0), _cacheTileBelow(0)
+TileEngine::TileEngine(SavedBattleGame *save, std::vector<Uint16> *voxelData) : _save(save), _voxelData(voxelData), _personalLighting(true), _cacheTile(0), _cacheTileBelow(0),
+	_sightRevision(Tile::getGeometryRevision()), _sightHits(0), _sightMisses(0), _sightInvalidations(0)
 {
 	_cacheTilePos = Position(-1,-1,-1);
 }
@@ -538,8 +540,6 @@ int TileEngine::checkVoxelExposure(Position *originVoxel, Tile *tile, BattleUnit
  */
 bool TileEngine::canTargetUnit(Position *originVoxel, Tile *tile, Position *scanVoxel, BattleUnit *excludeUnit, bool rememberObstacles, BattleUnit *potentialUnit)
 {
-	Position targetVoxel = Position((tile->getPosition().x * 16) + 8, (tile->getPosition().y * 16) + 8, tile->getPosition().z * 24);
-	std::vector<Position> _trajectory;
 	bool hypothetical = potentialUnit != 0;
 	if (potentialUnit == 0)
 	{
@@ -549,6 +549,64 @@ bool TileEngine::canTargetUnit(Position *originVoxel, Tile *tile, Position *scan
 
 	if (potentialUnit == excludeUnit) return false; //skip self
 
+	// obstacles are marked on the tiles as a side effect, so those checks always cast their rays
+	if (rememberObstacles)
+	{
+		return scanUnit(originVoxel, tile, scanVoxel, excludeUnit, rememberObstacles, potentialUnit, hypothetical);
+	}
+
+	// the rays only depend on the terrain and the units in the way, so the result holds until any of those change
+	if (_sightRevision != Tile::getGeometryRevision())
+	{
+		if (!_sightCache.empty())
+		{
+			_sightCache.clear();
+			++_sightInvalidations;
+		}
+		_sightRevision = Tile::getGeometryRevision();
+	}
+
+	SightKey key;
+	key.origin = *originVoxel;
+	key.target = tile->getPosition();
+	key.unitPosition = potentialUnit->getPosition();
+	key.excludeUnit = excludeUnit;
+	key.potentialUnit = potentialUnit;
+	key.hypothetical = hypothetical;
+	key.out = potentialUnit->isOut();
+
+	std::map<SightKey, SightResult>::const_iterator i = _sightCache.find(key);
+	if (i != _sightCache.end())
+	{
+		++_sightHits;
+		*scanVoxel = i->second.scanVoxel;
+		return i->second.visible;
+	}
+	++_sightMisses;
+
+	SightResult result;
+	result.visible = scanUnit(originVoxel, tile, scanVoxel, excludeUnit, rememberObstacles, potentialUnit, hypothetical);
+	result.scanVoxel = *scanVoxel;
+	_sightCache[key] = result;
+	return result.visible;
+}
+
+/**
+ * Casts the rays of a line of fire check against a unit.
+ * @param originVoxel Voxel of trace origin (eye or gun's barrel).
+ * @param tile The tile to check for.
+ * @param scanVoxel is returned coordinate of hit.
+ * @param excludeUnit is self (not to hit self).
+ * @param rememberObstacles Remember obstacles for no LOF indicator?
+ * @param potentialUnit The unit to check for, either the one on the tile or a hypothetical one.
+ * @param hypothetical Is the unit only hypothetically on the tile?
+ * @return True if the unit can be targetted.
+ */
+bool TileEngine::scanUnit(Position *originVoxel, Tile *tile, Position *scanVoxel, BattleUnit *excludeUnit, bool rememberObstacles, BattleUnit *potentialUnit, bool hypothetical)
+{
+	Position targetVoxel = Position((tile->getPosition().x * 16) + 8, (tile->getPosition().y * 16) + 8, tile->getPosition().z * 24);
+	std::vector<Position> _trajectory;
+
 	int targetMinHeight = targetVoxel.z - tile->getTerrainLevel();
 	targetMinHeight += potentialUnit->getFloatHeight();
 
@@ -823,9 +881,10 @@ void TileEngine::calculateFOV(Position position)
  * Checks if a sniper from the opposing faction sees this unit. The unit with the highest reaction score will be compared with the current unit's reaction score.
  * If it's higher, a shot is fired when enough time units, a weapon and ammo are available.
  * @param unit The unit to check reaction fire upon.
+ * @param fovUpdated True if the field of view of every unit around this unit was just recalculated.
  * @return True if reaction fire took place.
  */
-bool TileEngine::checkReactionFire(BattleUnit *unit)
+bool TileEngine::checkReactionFire(BattleUnit *unit, bool fovUpdated)
 {
 	// reaction fire only triggered when the actioning unit is of the currently playing side, and is still on the map (alive)
 	if (unit->getFaction() != _save->getSide() || unit->getTile() == 0)
@@ -833,7 +892,7 @@ bool TileEngine::checkReactionFire(BattleUnit *unit)
 		return false;
 	}
 
-	std::vector<std::pair<BattleUnit *, int> > spotters = getSpottingUnits(unit);
+	std::vector<std::pair<BattleUnit *, int> > spotters = getSpottingUnits(unit, fovUpdated);
 	bool result = false;
 
 	// not mind controlled, or controlled by the player
@@ -871,10 +930,14 @@ bool TileEngine::checkReactionFire(BattleUnit *unit)
 
 /**
  * Creates a vector of units that can spot this unit.
+ * When the field of view of the surrounding units is up to date, their visible unit
+ * lists already hold everything that passes the view sector and line of sight tests,
+ * so only those units (and the ones that were hit) need the full voxel checks.
  * @param unit The unit to check for spotters of.
+ * @param fovUpdated True if the field of view of every unit around this unit was just recalculated.
  * @return A vector of units that can see this unit.
  */
-std::vector<std::pair<BattleUnit *, int> > TileEngine::getSpottingUnits(BattleUnit* unit)
+std::vector<std::pair<BattleUnit *, int> > TileEngine::getSpottingUnits(BattleUnit* unit, bool fovUpdated)
 {
 	std::vector<std::pair<BattleUnit *, int> > spotters;
 	Tile *tile = unit->getTile();
@@ -897,12 +960,6 @@ std::vector<std::pair<BattleUnit *, int> > TileEngine::getSpottingUnits(BattleUn
 				// closer than 20 tiles
 				distanceSq(unit->getPosition(), (*i)->getPosition()) <= MAX_VIEW_DISTANCE_SQR)
 			{
-				BattleAction falseAction;
-				falseAction.type = BA_SNAPSHOT;
-				falseAction.actor = *i;
-				falseAction.target = unit->getPosition();
-				Position originVoxel = getOriginVoxel(falseAction, 0);
-				Position targetVoxel;
 				AIModule *ai = (*i)->getAIModule();
 
 				// Inquisitor's note regarding 'gotHit' variable
@@ -922,6 +979,23 @@ std::vector<std::pair<BattleUnit *, int> > TileEngine::getSpottingUnits(BattleUn
 
 				bool gotHit = (ai != 0 && ai->getWasHitBy(unit->getId())) || (ai == 0 && (*i)->getHitState());
 
+				// the field of view follows the turret, the view sector below doesn't, so those can't be skipped
+				if (fovUpdated && !gotHit && !(Options::strafe && (*i)->getTurretType() > -1))
+				{
+					std::vector<BattleUnit*> *visibleUnits = (*i)->getVisibleUnits();
+					if (std::find(visibleUnits->begin(), visibleUnits->end(), unit) == visibleUnits->end())
+					{
+						continue;
+					}
+				}
+
+				BattleAction falseAction;
+				falseAction.type = BA_SNAPSHOT;
+				falseAction.actor = *i;
+				falseAction.target = unit->getPosition();
+				Position originVoxel = getOriginVoxel(falseAction, 0);
+				Position targetVoxel;
+
 					// can actually see the target Tile, or we got hit
 				if (((*i)->checkViewSector(unit->getPosition()) || gotHit) &&
 					// can actually target the unit
@@ -952,11 +1026,11 @@ std::vector<std::pair<BattleUnit *, int> > TileEngine::getSpottingUnits(BattleUn
  * @param unit The unit to check scores against.
  * @return The unit with the highest reactions.
  */
-BattleUnit* TileEngine::getReactor(std::vector<std::pair<BattleUnit *, int> > spotters, int &attackType, BattleUnit *unit)
+BattleUnit* TileEngine::getReactor(const std::vector<std::pair<BattleUnit *, int> > &spotters, int &attackType, BattleUnit *unit)
 {
 	int bestScore = -1;
 	BattleUnit *bu = 0;
-	for (std::vector<std::pair<BattleUnit *, int> >::iterator i = spotters.begin(); i != spotters.end(); ++i)
+	for (std::vector<std::pair<BattleUnit *, int> >::const_iterator i = spotters.begin(); i != spotters.end(); ++i)
 	{
 		if (!(*i).first->isOut() &&
 		!(*i).first->getRespawn() &&
@@ -2639,6 +2713,68 @@ void TileEngine::voxelCheckFlush()
 	_cacheTileBelow = 0;
 }
 
+/**
+ * Compares two sight cache keys, so they can be stored in a map.
+ * @param other The key to compare with.
+ * @return True if this key sorts before the other one.
+ */
+bool TileEngine::SightKey::operator<(const SightKey &other) const
+{
+	const Position *lhs[] = { &origin, &target, &unitPosition };
+	const Position *rhs[] = { &other.origin, &other.target, &other.unitPosition };
+	for (int i = 0; i < 3; ++i)
+	{
+		if (lhs[i]->x != rhs[i]->x) return lhs[i]->x < rhs[i]->x;
+		if (lhs[i]->y != rhs[i]->y) return lhs[i]->y < rhs[i]->y;
+		if (lhs[i]->z != rhs[i]->z) return lhs[i]->z < rhs[i]->z;
+	}
+	if (excludeUnit != other.excludeUnit) return excludeUnit < other.excludeUnit;
+	if (potentialUnit != other.potentialUnit) return potentialUnit < other.potentialUnit;
+	if (hypothetical != other.hypothetical) return hypothetical < other.hypothetical;
+	return out < other.out;
+}
+
+/**
+ * Forgets all remembered line of fire checks and resets the counters.
+ * Called at the end of every turn.
+ */
+void TileEngine::clearSightCache()
+{
+	_sightCache.clear();
+	_sightRevision = Tile::getGeometryRevision();
+	_sightHits = 0;
+	_sightMisses = 0;
+	_sightInvalidations = 0;
+}
+
+/**
+ * Gets the number of line of fire checks answered from the sight cache this turn.
+ * @return Number of cache hits.
+ */
+int TileEngine::getSightCacheHits() const
+{
+	return _sightHits;
+}
+
+/**
+ * Gets the number of line of fire checks that had to cast their rays this turn.
+ * @return Number of cache misses.
+ */
+int TileEngine::getSightCacheMisses() const
+{
+	return _sightMisses;
+}
+
+/**
+ * Gets the number of times the sight cache was thrown away this turn
+ * because the terrain or a unit changed.
+ * @return Number of invalidations.
+ */
+int TileEngine::getSightCacheInvalidations() const
+{
+	return _sightInvalidations;
+}
+
 /**
  * Toggles personal lighting on / off.
  */
@@ -18,6 +18,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <vector>
+#include <map>
 #include "Position.h"
 #include "../Mod/RuleItem.h"
 #include "../Mod/MapData.h"
@@ -50,6 +51,24 @@ private:
 	Tile *_cacheTile;
 	Tile *_cacheTileBelow;
 	Position _cacheTilePos;
+	/// A line of fire check against a unit, as remembered by the sight cache.
+	struct SightKey
+	{
+		Position origin, target, unitPosition;
+		BattleUnit *excludeUnit, *potentialUnit;
+		bool hypothetical, out;
+		bool operator<(const SightKey &other) const;
+	};
+	struct SightResult
+	{
+		bool visible;
+		Position scanVoxel;
+	};
+	std::map<SightKey, SightResult> _sightCache;
+	unsigned int _sightRevision;
+	int _sightHits, _sightMisses, _sightInvalidations;
+	/// Casts the rays checking if a unit can be targeted.
+	bool scanUnit(Position *originVoxel, Tile *tile, Position *scanVoxel, BattleUnit *excludeUnit, bool rememberObstacles, BattleUnit *potentialUnit, bool hypothetical);
 public:
 	static const int MAX_DARKNESS_TO_SEE_UNITS = 9;
 	/// Creates a new TileEngine class.
@@ -65,7 +84,7 @@ public:
 	/// Calculates the field of view within range of a certain position.
 	void calculateFOV(Position position);
 	/// Checks reaction fire.
-	bool checkReactionFire(BattleUnit *unit);
+	bool checkReactionFire(BattleUnit *unit, bool fovUpdated = false);
 	/// Recalculates lighting of the battlescape for terrain.
 	void calculateTerrainLighting();
 	/// Recalculates lighting of the battlescape for units.
@@ -126,6 +145,14 @@ public:
 	VoxelType voxelCheck(Position voxel, BattleUnit *excludeUnit, bool excludeAllUnits = false, bool onlyVisible = false, BattleUnit *excludeAllBut = 0);
 	/// Flushes cache of voxel check
 	void voxelCheckFlush();
+	/// Forgets all remembered line of fire checks.
+	void clearSightCache();
+	/// Gets the number of line of fire checks answered from the sight cache.
+	int getSightCacheHits() const;
+	/// Gets the number of line of fire checks that had to cast rays.
+	int getSightCacheMisses() const;
+	/// Gets the number of times the sight cache was thrown away.
+	int getSightCacheInvalidations() const;
 	/// Blows this tile up.
 	bool detonate(Tile* tile);
 	/// Validates a throwing action.
@@ -133,9 +160,9 @@ public:
 	/// Opens any doors this door is connected to.
 	void checkAdjacentDoors(const Position& pos, TilePart part);
 	/// Creates a vector of units that can spot this unit.
-	std::vector<std::pair<BattleUnit *, int> > getSpottingUnits(BattleUnit* unit);
+	std::vector<std::pair<BattleUnit *, int> > getSpottingUnits(BattleUnit* unit, bool fovUpdated = false);
 	/// Given a vector of spotters, and a unit, picks the spotter with the highest reaction score.
-	BattleUnit* getReactor(std::vector<std::pair<BattleUnit *, int> > spotters, int &attackType, BattleUnit *unit);
+	BattleUnit* getReactor(const std::vector<std::pair<BattleUnit *, int> > &spotters, int &attackType, BattleUnit *unit);
 	/// Checks validity of a snap shot to this position.
 	int determineReactionType(BattleUnit *unit, BattleUnit *target);
 	/// Tries to perform a reaction snap shot to this location.
@@ -217,7 +217,7 @@ void UnitWalkBState::think()
 			// check for reaction fire
 			if (!_falling)
 			{
-				if (_terrain->checkReactionFire(_unit))
+				if (_terrain->checkReactionFire(_unit, true))
 				{
 					// unit got fired upon - stop walking
 					_unit->setCache(0);
@@ -18,36 +18,43 @@
  */
 
 #include "CatFile.h"
+#include <algorithm>
+#include <cstring>
 #include <SDL.h>
 
 namespace OpenXcom
 {
 
 /**
- * Creates a CAT file stream. A CAT file starts with an index of the
+ * Creates a CAT file. A CAT file starts with an index of the
  * offset and size of every file contained within. Each file consists
  * of a filename followed by its contents.
  * @param path Full path to CAT file.
  */
-CatFile::CatFile(const char *path) : std::ifstream(path, std::ios::in | std::ios::binary), _amount(0), _offset(0), _size(0)
+CatFile::CatFile(const char *path) : _file(path), _amount(0), _offset(0), _size(0)
 {
+	const unsigned char *data = _file.getData();
+	size_t size = _file.getSize();
+
 	// Get amount of files
-	read((char*)&_amount, sizeof(_amount));
+	if (size >= sizeof(_amount))
+	{
+		memcpy(&_amount, data, sizeof(_amount));
+	}
 
 	_amount = (unsigned int)SDL_SwapLE32(_amount);
 	_amount /= 2 * sizeof(_amount);
+	_amount = (unsigned int)std::min<size_t>(_amount, size / (2 * sizeof(_amount)));
 
 	// Get object offsets
-	seekg(0, std::ios::beg);
-
 	_offset = new unsigned int[_amount];
 	_size   = new unsigned int[_amount];
 
 	for (unsigned int i = 0; i < _amount; ++i)
 	{
-		read((char*)&_offset[i], sizeof(*_offset));
+		memcpy(&_offset[i], data + i * 2 * sizeof(*_offset), sizeof(*_offset));
 		_offset[i] = (unsigned int)SDL_SwapLE32(_offset[i]);
-		read((char*)&_size[i],   sizeof(*_size));
+		memcpy(&_size[i], data + i * 2 * sizeof(*_offset) + sizeof(*_offset), sizeof(*_size));
 		_size[i] = (unsigned int)SDL_SwapLE32(_size[i]);
 	}
 }
@@ -59,8 +66,6 @@ CatFile::~CatFile()
 {
 	delete[] _offset;
 	delete[] _size;
-
-	close();
 }
 
 /**
@@ -74,15 +79,17 @@ char *CatFile::load(unsigned int i, bool name)
 	if (i >= _amount)
 		return 0;
 
-	seekg(_offset[i], std::ios::beg);
+	const unsigned char *data = _file.getData();
+	size_t size = _file.getSize();
+	size_t offset = std::min<size_t>(_offset[i], size);
 
-	unsigned char namesize = peek();
+	unsigned char namesize = (offset < size) ? data[offset] : 0;
 	// Skip filename (if there's any)
 	if (namesize<=56)
 	{
 		if (!name)
 		{
-			seekg(namesize + 1, std::ios::cur);
+			offset = std::min<size_t>(offset + namesize + 1, size);
 		}
 		else
 		{
@@ -90,9 +97,11 @@ char *CatFile::load(unsigned int i, bool name)
 		}
 	}
 
-	// Read object
+	// Read object, whatever is past the end of the file is left blank
 	char *object = new char[_size[i]];
-	read(object, _size[i]);
+	size_t available = std::min<size_t>(_size[i], size - offset);
+	memcpy(object, data + offset, available);
+	memset(object + available, 0, _size[i] - available);
 
 	return object;
 }
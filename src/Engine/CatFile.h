@@ -17,27 +17,28 @@
  * You should have received a copy of the GNU General Public License
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
-#include <fstream>
+#include "MappedFile.h"
 
 namespace OpenXcom
 {
 
 /**
- * Subclass of std::ifstream to handle CAT files
+ * Read-only view of a CAT file, backed by a mapped file
  */
-class CatFile : protected std::ifstream
+class CatFile
 {
 private:
+	MappedFile _file;
 	unsigned int _amount, *_offset, *_size;
 public:
-	/// Creates a CAT file stream.
+	/// Creates a CAT file.
 	CatFile(const char *path);
-	/// Cleans up the stream.
+	/// Cleans up the file.
 	~CatFile();
 	/// Inherit operator.
 	bool operator !() const
 	{
-		return std::ifstream::operator!();
+		return !_file;
 	}
 	/// Get amount of objects.
 	int getAmount() const
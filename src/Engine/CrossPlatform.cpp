@@ -42,6 +42,7 @@
 #include <shlobj.h>
 #include <shlwapi.h>
 #include <shellapi.h>
+#include <psapi.h>
 #ifndef __NO_DBGHELP
 #include <dbghelp.h>
 #endif
@@ -53,6 +54,7 @@
 #pragma comment(lib, "advapi32.lib")
 #pragma comment(lib, "shell32.lib")
 #pragma comment(lib, "shlwapi.lib")
+#pragma comment(lib, "psapi.lib")
 #ifndef __NO_DBGHELP
 #pragma comment(lib, "dbghelp.lib")
 #endif
@@ -72,6 +74,7 @@
 #include <execinfo.h>
 #include <cxxabi.h>
 #include <dlfcn.h>
+#include <sys/resource.h>
 #include "Unicode.h"
 #endif
 #include <SDL.h>
@@ -1295,6 +1298,33 @@ std::string getExeFolder()
 	return std::string();
 }
 
+/**
+ * Gets the most memory the game has used so far.
+ * @return Peak resident memory in bytes, or 0 if unknown.
+ */
+size_t getPeakMemory()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+	{
+		return counters.PeakWorkingSetSize;
+	}
+	return 0;
+#else
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+	{
+		return 0;
+	}
+#ifdef __APPLE__
+	return usage.ru_maxrss;
+#else
+	return usage.ru_maxrss * 1024;
+#endif
+#endif
+}
+
 }
 
 }
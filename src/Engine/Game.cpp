@@ -150,11 +150,7 @@ void Game::run()
 	while (!_quit)
 	{
 		// Clean up states
-		while (!_deleted.empty())
-		{
-			delete _deleted.back();
-			_deleted.pop_back();
-		}
+		deleteStates();
 
 		// Initialize active state
 		if (!_init)
@@ -453,6 +449,10 @@ void Game::pushState(State *state)
 {
 	_states.push_back(state);
 	_init = false;
+	if (_mod)
+	{
+		_mod->pushResidencyOwner(state);
+	}
 }
 
 /**
@@ -466,6 +466,31 @@ void Game::popState()
 	_deleted.push_back(_states.back());
 	_states.pop_back();
 	_init = false;
+	if (_mod)
+	{
+		_mod->setResidencyOwner(_states.empty() ? 0 : _states.back());
+	}
+}
+
+/**
+ * Deletes the states that were popped from the state stack,
+ * along with the resources only they were using.
+ */
+void Game::deleteStates()
+{
+	while (!_deleted.empty())
+	{
+		if (_mod)
+		{
+			_mod->releaseResources(_deleted.back());
+		}
+		delete _deleted.back();
+		_deleted.pop_back();
+	}
+	if (_mod)
+	{
+		_mod->updateResidency();
+	}
 }
 
 /**
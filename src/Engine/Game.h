@@ -80,6 +80,8 @@ public:
 	void pushState(State *state);
 	/// Pops the last state from the state stack.
 	void popState();
+	/// Deletes the states popped from the state stack.
+	void deleteStates();
 	/// Gets the currently loaded language.
 	Language *getLanguage() const;
 	/// Gets the currently loaded saved game.
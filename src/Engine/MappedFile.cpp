@@ -0,0 +1,137 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "MappedFile.h"
+#include <fstream>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace OpenXcom
+{
+
+/**
+ * Maps the contents of a file into memory. If the file can't
+ * be mapped (eg. it's empty or the platform doesn't allow it),
+ * it's read into a buffer instead, so callers don't need to care.
+ * @param path Full path to the file.
+ */
+MappedFile::MappedFile(const std::string &path) : _data(0), _size(0), _mapped(false)
+#ifdef _WIN32
+	, _file(INVALID_HANDLE_VALUE), _mapping(0)
+#endif
+{
+#ifdef _WIN32
+	_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+	if (_file != INVALID_HANDLE_VALUE)
+	{
+		LARGE_INTEGER size;
+		if (GetFileSizeEx(_file, &size) && size.QuadPart > 0)
+		{
+			_mapping = CreateFileMappingA(_file, 0, PAGE_READONLY, 0, 0, 0);
+			if (_mapping)
+			{
+				_data = (const unsigned char*)MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0);
+				if (_data)
+				{
+					_size = (size_t)size.QuadPart;
+					_mapped = true;
+					return;
+				}
+			}
+		}
+	}
+#else
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd != -1)
+	{
+		struct stat info;
+		if (fstat(fd, &info) == 0 && info.st_size > 0)
+		{
+			void *data = mmap(0, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (data != MAP_FAILED)
+			{
+				_data = (const unsigned char*)data;
+				_size = info.st_size;
+				_mapped = true;
+			}
+		}
+		close(fd);
+		if (_mapped)
+		{
+			return;
+		}
+	}
+#endif
+	readFile(path);
+}
+
+/**
+ * Unmaps the file.
+ */
+MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+	if (_mapped)
+	{
+		UnmapViewOfFile(_data);
+	}
+	if (_mapping)
+	{
+		CloseHandle(_mapping);
+	}
+	if (_file != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(_file);
+	}
+#else
+	if (_mapped)
+	{
+		munmap((void*)_data, _size);
+	}
+#endif
+}
+
+/**
+ * Reads the whole file into a buffer.
+ * @param path Full path to the file.
+ */
+void MappedFile::readFile(const std::string &path)
+{
+	std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+	if (!file)
+	{
+		return;
+	}
+	_buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	// an empty file is still a valid file
+	_buffer.push_back(0);
+	_data = &_buffer[0];
+	_size = _buffer.size() - 1;
+}
+
+}
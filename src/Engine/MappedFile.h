@@ -0,0 +1,72 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <vector>
+#include <stddef.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Read-only view of a whole file's contents. The file is
+ * memory-mapped where the platform supports it, so resource
+ * decoders can read straight out of the page cache instead
+ * of going through a stream one byte at a time.
+ */
+class MappedFile
+{
+private:
+	const unsigned char *_data;
+	size_t _size;
+	bool _mapped;
+	std::vector<unsigned char> _buffer;
+#ifdef _WIN32
+	void *_file, *_mapping;
+#endif
+
+	/// Reads the file into memory when it can't be mapped.
+	void readFile(const std::string &path);
+	/// Files can't be copied.
+	MappedFile(const MappedFile&);
+	/// Files can't be copied.
+	MappedFile &operator=(const MappedFile&);
+public:
+	/// Maps a file into memory.
+	MappedFile(const std::string &path);
+	/// Unmaps the file.
+	~MappedFile();
+	/// Checks if the file couldn't be opened.
+	bool operator !() const
+	{
+		return _data == 0;
+	}
+	/// Gets the file contents.
+	const unsigned char *getData() const
+	{
+		return _data;
+	}
+	/// Gets the file size.
+	size_t getSize() const
+	{
+		return _size;
+	}
+};
+
+}
@@ -23,6 +23,7 @@
 #include <SDL_keysym.h>
 #include <SDL_mixer.h>
 #include <stdio.h>
+#include <time.h>
 #include <iostream>
 #include <map>
 #include <sstream>
@@ -53,6 +54,10 @@ std::map<std::string, std::string> _commandLine;
 std::vector<OptionInfo> _info;
 std::map<std::string, ModInfo> _modInfos;
 std::string _masterMod;
+int _simulateMonths = 0;
+uint64_t _simulateSeed = 0;
+int _simulateRuns = 1;
+int _simulateJobs = 0;
 
 /**
  * Sets up the options by creating their OptionInfo metadata.
@@ -143,6 +148,8 @@ void create()
 	_info.push_back(OptionInfo("touchEnabled", &touchEnabled, false));
 	_info.push_back(OptionInfo("rootWindowedMode", &rootWindowedMode, false));
 	_info.push_back(OptionInfo("lazyLoadResources", &lazyLoadResources, true));
+	_info.push_back(OptionInfo("resourceMemoryBudget", &resourceMemoryBudget, 0));
+	_info.push_back(OptionInfo("terrainMemoryBudget", &terrainMemoryBudget, 32));
 	_info.push_back(OptionInfo("backgroundMute", &backgroundMute, false));
 
 	// advanced options
@@ -395,6 +402,22 @@ void loadArgs(int argc, char *argv[])
 				{
 					_masterMod = argv[i];
 				}
+				else if (argname == "simulate")
+				{
+					std::istringstream(argv[i]) >> _simulateMonths;
+				}
+				else if (argname == "seed")
+				{
+					std::istringstream(argv[i]) >> _simulateSeed;
+				}
+				else if (argname == "runs")
+				{
+					std::istringstream(argv[i]) >> _simulateRuns;
+				}
+				else if (argname == "jobs")
+				{
+					std::istringstream(argv[i]) >> _simulateJobs;
+				}
 				else
 				{
 					//save this command line option for now, we will apply it later
@@ -427,6 +450,14 @@ bool showHelp(int argc, char *argv[])
 	help << "        use PATH as the default Config Folder instead of auto-detecting" << std::endl << std::endl;
 	help << "-master MOD" << std::endl;
 	help << "        set MOD to the current master mod (eg. -master xcom2)" << std::endl << std::endl;
+	help << "-simulate MONTHS" << std::endl;
+	help << "        run a new campaign without a player for MONTHS months and report timings" << std::endl << std::endl;
+	help << "-seed SEED" << std::endl;
+	help << "        use SEED as the random seed for -simulate (default: 0, picks one from the clock)" << std::endl << std::endl;
+	help << "-runs N" << std::endl;
+	help << "        simulate N campaigns with consecutive seeds from SEED and sum up the outcomes" << std::endl << std::endl;
+	help << "-jobs N" << std::endl;
+	help << "        simulate up to N campaigns at a time for -runs (default: one per core)" << std::endl << std::endl;
 	help << "-KEY VALUE" << std::endl;
 	help << "        override option KEY with VALUE (eg. -displayWidth 640)" << std::endl << std::endl;
 	help << "-version" << std::endl;
@@ -568,8 +599,23 @@ bool init(int argc, char *argv[])
 	_setDefaultMods();
 	updateOptions();
 
+	if (_simulateMonths > 0 && _simulateSeed == 0)
+	{
+		_simulateSeed = time(0);
+	}
+
 	std::string s = getUserFolder();
-	s += "openxcom.log";
+	if (_simulateMonths > 0 && _simulateRuns == 1)
+	{
+		// every simulated campaign gets its own log so they can run side by side
+		std::ostringstream ss;
+		ss << "simulate-" << _simulateSeed << ".log";
+		s += ss.str();
+	}
+	else
+	{
+		s += "openxcom.log";
+	}
 	Logger::logFile() = s;
 	FILE *file = fopen(Logger::logFile().c_str(), "w");
 	if (file)
@@ -751,6 +797,42 @@ std::string getActiveMaster()
 	return _masterMod;
 }
 
+/**
+ * Gets how many months to simulate from the command-line.
+ * @return Number of months, or 0 to play normally.
+ */
+int getSimulateMonths()
+{
+	return _simulateMonths;
+}
+
+/**
+ * Gets the random seed to simulate with from the command-line.
+ * @return Random seed.
+ */
+uint64_t getSimulateSeed()
+{
+	return _simulateSeed;
+}
+
+/**
+ * Gets how many campaigns to simulate from the command-line.
+ * @return Number of campaigns.
+ */
+int getSimulateRuns()
+{
+	return _simulateRuns;
+}
+
+/**
+ * Gets how many campaigns to simulate at a time from the command-line.
+ * @return Number of campaigns, or 0 for one per core.
+ */
+int getSimulateJobs()
+{
+	return _simulateJobs;
+}
+
 static void _loadMod(const ModInfo &modInfo, std::set<std::string> circDepCheck)
 {
 	if (circDepCheck.end() != circDepCheck.find(modInfo.getId()))
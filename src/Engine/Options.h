@@ -102,6 +102,14 @@ namespace Options
 	void switchDisplay();
 	/// returns the id of the active master mod
 	std::string getActiveMaster();
+	/// Gets the number of months to simulate.
+	int getSimulateMonths();
+	/// Gets the random seed to simulate with.
+	uint64_t getSimulateSeed();
+	/// Gets the number of campaigns to simulate.
+	int getSimulateRuns();
+	/// Gets the number of campaigns to simulate at a time.
+	int getSimulateJobs();
 	/// Maps resources in active mods to the virtual file system
 	void mapResources();
 	/// Gets the map of mod ids to mod infos
@@ -29,6 +29,69 @@ namespace OpenXcom
 namespace RNG
 {
 
+namespace
+{
+
+/// Number of steps between two sub-streams of the same stream.
+const int SUBSTREAM_SHIFT = 40;
+
+/**
+ * The xorshift step is linear over GF(2), so it can be written as
+ * a 64x64 bit matrix. Holds the matrices for 2^k steps, stored
+ * as one column per bit, so that jumping ahead only needs one
+ * matrix-vector product per bit of the step count.
+ */
+struct JumpTable
+{
+	uint64_t power[64][64];
+
+	static uint64_t step(uint64_t x)
+	{
+		x ^= x >> 12; // a
+		x ^= x << 25; // b
+		x ^= x >> 27; // c
+		return x;
+	}
+
+	static uint64_t apply(const uint64_t *matrix, uint64_t x)
+	{
+		uint64_t result = 0;
+		for (int bit = 0; x != 0; ++bit, x >>= 1)
+		{
+			if (x & 1)
+				result ^= matrix[bit];
+		}
+		return result;
+	}
+
+	JumpTable()
+	{
+		for (int bit = 0; bit < 64; ++bit)
+		{
+			power[0][bit] = step((uint64_t)1 << bit);
+		}
+		for (int k = 1; k < 64; ++k)
+		{
+			for (int bit = 0; bit < 64; ++bit)
+			{
+				power[k][bit] = apply(power[k - 1], power[k - 1][bit]);
+			}
+		}
+	}
+};
+
+const JumpTable &getJumpTable()
+{
+	static const JumpTable table;
+	return table;
+}
+
+RandomState _streams[STREAM_COUNT];
+thread_local RandomState *_current = &_streams[STREAM_GEOSCAPE];
+bool _seeded = (setSeed(time(0)), true);
+
+}
+
 /*  Written in 2014 by Sebastiano Vigna (vigna@acm.org)
 
 To the extent possible under law, the author has dedicated all copyright
@@ -41,14 +104,147 @@ See <http://creativecommons.org/publicdomain/zero/1.0/>. */
    rather suggest to use a xorshift128+ (for maximum speed) or
    xorshift1024* (for speed and very long period) generator. */
 
-uint64_t x = time(0); /* The state must be seeded with a nonzero value. */
+/**
+ * Creates a random state.
+ * @param seed Initial seed.
+ */
+RandomState::RandomState(uint64_t seed)
+{
+	setSeed(seed);
+}
+
+/**
+ * Changes the seed of this sequence.
+ * @param n New seed.
+ */
+void RandomState::setSeed(uint64_t n)
+{
+	/* The state must be seeded with a nonzero value. */
+	_seed = n ? n : UINT64_MAX;
+}
+
+/**
+ * Advances the sequence and returns the new number.
+ * @return Random number over the whole 64-bit range.
+ */
+uint64_t RandomState::next()
+{
+	_seed ^= _seed >> 12; // a
+	_seed ^= _seed << 25; // b
+	_seed ^= _seed >> 27; // c
+	return _seed * 2685821657736338717ULL;
+}
+
+/**
+ * Generates a random integer number within a certain range.
+ * @param min Minimum number, inclusive.
+ * @param max Maximum number, inclusive.
+ * @return Generated number.
+ */
+int RandomState::generate(int min, int max)
+{
+	uint64_t num = next();
+	return (int)(num % (max - min + 1) + min);
+}
+
+/**
+ * Generates a random decimal number within a certain range.
+ * @param min Minimum number.
+ * @param max Maximum number.
+ * @return Generated number.
+ */
+double RandomState::generate(double min, double max)
+{
+	double num = next();
+	return (num / ((double)UINT64_MAX / (max - min)) + min);
+}
+
+/**
+ * Generates a random percent chance of an event occurring,
+ * and returns the result
+ * @param value Value percentage (0-100%)
+ * @return True if the chance succeeded.
+ */
+bool RandomState::percent(int value)
+{
+	return (generate(0, 99) < value);
+}
+
+/**
+ * Advances the sequence as if next() was called
+ * the given number of times, in at most 64 matrix steps.
+ * @param steps Number of steps to skip.
+ */
+void RandomState::jump(uint64_t steps)
+{
+	const JumpTable &table = getJumpTable();
+	for (int k = 0; steps != 0; ++k, steps >>= 1)
+	{
+		if (steps & 1)
+			_seed = JumpTable::apply(table.power[k], _seed);
+	}
+}
+
+/**
+ * Gets a copy of this sequence jumped ahead to the start of a
+ * sub-stream. Sub-streams are 2^40 numbers apart, so workers
+ * drawing from different indices never overlap and always
+ * get the same numbers however they are scheduled.
+ * @param index Sub-stream index, below 2^24.
+ * @return Random state of the sub-stream.
+ */
+RandomState RandomState::subStream(uint64_t index) const
+{
+	RandomState sub(*this);
+	sub.jump(index << SUBSTREAM_SHIFT);
+	return sub;
+}
+
+/**
+ * Makes the current thread draw from one of the game streams.
+ * @param stream Stream to use.
+ */
+StreamScope::StreamScope(RandomStream stream) : _previous(_current)
+{
+	_current = &_streams[stream];
+}
+
+/**
+ * Makes the current thread draw from a local random state,
+ * usually a sub-stream given to a worker.
+ * @param state Random state to use.
+ */
+StreamScope::StreamScope(RandomState &state) : _previous(_current)
+{
+	_current = &state;
+}
 
-uint64_t next()
+/**
+ * Restores the stream that was in use before.
+ */
+StreamScope::~StreamScope()
 {
-	x ^= x >> 12; // a
-	x ^= x << 25; // b
-	x ^= x >> 27; // c
-	return x * 2685821657736338717ULL;
+	_current = _previous;
+}
+
+/**
+ * Returns one of the game streams.
+ * @param stream Stream ID.
+ * @return Random state of the stream.
+ */
+RandomState &getStream(RandomStream stream)
+{
+	return _streams[stream];
+}
+
+/**
+ * Changes the stream the current thread draws from,
+ * eg. when switching between geoscape and battlescape.
+ * @param stream Stream to use.
+ */
+void setStream(RandomStream stream)
+{
+	_current = &_streams[stream];
 }
 
 /**
@@ -57,16 +253,22 @@ uint64_t next()
  */
 uint64_t getSeed()
 {
-	return x;
+	return _current->getSeed();
 }
 
 /**
- * Changes the current seed in use by the generator.
+ * Reseeds every game stream from a single seed.
+ * The geoscape stream starts with the seed itself and
+ * the others start on their own sub-streams of it.
  * @param n New seed.
  */
 void setSeed(uint64_t n)
 {
-	x = n;
+	RandomState base(n);
+	for (int i = 0; i < STREAM_COUNT; ++i)
+	{
+		_streams[i] = base.subStream(i);
+	}
 }
 
 /**
@@ -77,8 +279,7 @@ void setSeed(uint64_t n)
  */
 int generate(int min, int max)
 {
-	uint64_t num = next();
-	return (int)(num % (max - min + 1) + min);
+	return _current->generate(min, max);
 }
 
 /**
@@ -89,8 +290,7 @@ int generate(int min, int max)
  */
 double generate(double min, double max)
 {
-	double num = next();
-	return (num / ((double)UINT64_MAX / (max - min)) + min);
+	return _current->generate(min, max);
 }
 
 /**
@@ -113,7 +313,7 @@ int seedless(int min, int max)
  */
 bool percent(int value)
 {
-	return (generate(0, 99) < value);
+	return _current->percent(value);
 }
 
 }
@@ -29,12 +29,69 @@ namespace OpenXcom
  * Random Number Generator used throughout the game
  * for all your randomness needs. Uses a 64-bit xorshift
  * pseudorandom number generator.
+ * The game draws from several independent streams so that
+ * e.g. map generation or cosmetic effects don't change the
+ * outcome of combat, and each stream can be split into
+ * sub-streams that don't overlap for worker threads.
  */
 namespace RNG
 {
-	/// Gets the seed in use.
+	/// Independent random streams used by the game.
+	enum RandomStream { STREAM_GEOSCAPE, STREAM_COMBAT, STREAM_AI, STREAM_MAPGEN, STREAM_COSMETIC, STREAM_COUNT };
+
+	/**
+	 * State of a single xorshift64* random sequence.
+	 */
+	class RandomState
+	{
+	private:
+		uint64_t _seed;
+	public:
+		/// Creates a random state with a seed.
+		explicit RandomState(uint64_t seed = 1);
+		/// Gets the seed in use.
+		uint64_t getSeed() const { return _seed; }
+		/// Sets the seed in use.
+		void setSeed(uint64_t n);
+		/// Generates the next raw random number.
+		uint64_t next();
+		/// Generates a random integer number, inclusive.
+		int generate(int min, int max);
+		/// Generates a random floating-point number.
+		double generate(double min, double max);
+		/// Generates a percentage chance.
+		bool percent(int value);
+		/// Advances the sequence by a number of steps.
+		void jump(uint64_t steps);
+		/// Gets a non-overlapping sub-stream of this sequence.
+		RandomState subStream(uint64_t index) const;
+	};
+
+	/**
+	 * Makes the functions in this namespace draw from a
+	 * different stream on the current thread until it
+	 * goes out of scope.
+	 */
+	class StreamScope
+	{
+	private:
+		RandomState *_previous;
+	public:
+		/// Switches to one of the game streams.
+		explicit StreamScope(RandomStream stream);
+		/// Switches to a local random state.
+		explicit StreamScope(RandomState &state);
+		/// Switches back to the previous stream.
+		~StreamScope();
+	};
+
+	/// Gets one of the game streams.
+	RandomState &getStream(RandomStream stream);
+	/// Sets the stream in use on the current thread.
+	void setStream(RandomStream stream);
+	/// Gets the seed in use by the current stream.
 	uint64_t getSeed();
-	/// Sets the seed in use.
+	/// Reseeds all the game streams.
 	void setSeed(uint64_t n);
 	/// Generates a random integer number, inclusive.
 	int generate(int min, int max);
@@ -27,6 +27,7 @@
 #include "../lodepng.h"
 #include "Palette.h"
 #include "Exception.h"
+#include "MappedFile.h"
 #include "Logger.h"
 #include "ShaderMove.h"
 #include "Unicode.h"
@@ -367,7 +368,7 @@ void Surface::loadImage(const std::string &filename)
 void Surface::loadSpk(const std::string &filename)
 {
 	// Load file and put pixels in surface
-	std::ifstream imgFile (filename.c_str(), std::ios::in | std::ios::binary);
+	MappedFile imgFile(filename);
 	if (!imgFile)
 	{
 		throw Exception(filename + " not found");
@@ -376,18 +377,25 @@ void Surface::loadSpk(const std::string &filename)
 	// Lock the surface
 	lock();
 
+	const Uint8 *data = imgFile.getData();
+	const Uint8 *end = data + imgFile.getSize();
 	Uint16 flag;
-	Uint8 value;
 	int x = 0, y = 0;
 
-	while (imgFile.read((char*)&flag, sizeof(flag)))
+	while (end - data >= (ptrdiff_t)sizeof(flag))
 	{
+		memcpy(&flag, data, sizeof(flag));
+		data += sizeof(flag);
 		flag = SDL_SwapLE16(flag);
 
 		if (flag == 65535)
 		{
-			imgFile.read((char*)&flag, sizeof(flag));
-			flag = SDL_SwapLE16(flag);
+			if (end - data >= (ptrdiff_t)sizeof(flag))
+			{
+				memcpy(&flag, data, sizeof(flag));
+				data += sizeof(flag);
+				flag = SDL_SwapLE16(flag);
+			}
 
 			for (int i = 0; i < flag * 2; ++i)
 			{
@@ -396,21 +404,22 @@ void Surface::loadSpk(const std::string &filename)
 		}
 		else if (flag == 65534)
 		{
-			imgFile.read((char*)&flag, sizeof(flag));
-			flag = SDL_SwapLE16(flag);
+			if (end - data >= (ptrdiff_t)sizeof(flag))
+			{
+				memcpy(&flag, data, sizeof(flag));
+				data += sizeof(flag);
+				flag = SDL_SwapLE16(flag);
+			}
 
-			for (int i = 0; i < flag * 2; ++i)
+			for (int i = 0; i < flag * 2 && data != end; ++i)
 			{
-				imgFile.read((char*)&value, 1);
-				setPixelIterative(&x, &y, value);
+				setPixelIterative(&x, &y, *data++);
 			}
 		}
 	}
 
 	// Unlock the surface
 	unlock();
-
-	imgFile.close();
 }
 
 /**
@@ -423,7 +432,7 @@ void Surface::loadSpk(const std::string &filename)
 void Surface::loadBdy(const std::string &filename)
 {
 	// Load file and put pixels in surface
-	std::ifstream imgFile (filename.c_str(), std::ios::in | std::ios::binary);
+	MappedFile imgFile(filename);
 	if (!imgFile)
 	{
 		throw Exception(filename + " not found");
@@ -432,17 +441,23 @@ void Surface::loadBdy(const std::string &filename)
 	// Lock the surface
 	lock();
 
+	const Uint8 *data = imgFile.getData();
+	const Uint8 *end = data + imgFile.getSize();
 	Uint8 dataByte;
 	int pixelCnt;
 	int x = 0, y = 0;
 	int currentRow = 0;
 
-	while (imgFile.read((char*)&dataByte, sizeof(dataByte)))
+	while (data != end)
 	{
+		dataByte = *data++;
 		if (dataByte >= 129)
 		{
 			pixelCnt = 257 - (int)dataByte;
-			imgFile.read((char*)&dataByte, sizeof(dataByte));
+			if (data != end)
+			{
+				dataByte = *data++;
+			}
 			currentRow = y;
 			for (int i = 0; i < pixelCnt; ++i)
 			{
@@ -457,7 +472,9 @@ void Surface::loadBdy(const std::string &filename)
 			currentRow = y;
 			for (int i = 0; i < pixelCnt; ++i)
 			{
-				imgFile.read((char*)&dataByte, sizeof(dataByte));
+				if (data == end)
+					break;
+				dataByte = *data++;
 				if (currentRow == y) // avoid overscan into next row
 					setPixelIterative(&x, &y, dataByte);
 			}
@@ -466,8 +483,6 @@ void Surface::loadBdy(const std::string &filename)
 
 	// Unlock the surface
 	unlock();
-
-	imgFile.close();
 }
 
 /**
@@ -17,14 +17,85 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "SurfaceSet.h"
-#include <fstream>
 #include <climits>
+#include <cstring>
+#include <algorithm>
 #include "Surface.h"
 #include "Exception.h"
+#include "MappedFile.h"
 
 namespace OpenXcom
 {
 
+namespace
+{
+
+/**
+ * Decodes one RLE compressed PCK frame.
+ * @param frame Surface to draw the frame in, or 0 to just skip over it.
+ * @param width Frame width in pixels.
+ * @param data Start of the frame data.
+ * @param end End of the PCK data.
+ * @param value Last value read, carried over between frames.
+ * @return Start of the next frame.
+ */
+const Uint8 *decodePckFrame(Surface *frame, int width, const Uint8 *data, const Uint8 *end, Uint8 &value)
+{
+	int x = 0, y = 0;
+
+	if (frame)
+	{
+		// Lock the surface
+		frame->lock();
+	}
+
+	if (data != end)
+	{
+		value = *data++;
+	}
+	if (frame)
+	{
+		for (int i = 0; i < value; ++i)
+		{
+			for (int j = 0; j < width; ++j)
+			{
+				frame->setPixelIterative(&x, &y, 0);
+			}
+		}
+	}
+
+	while (data != end && (value = *data++) != 255)
+	{
+		if (value == 254)
+		{
+			if (data != end)
+			{
+				value = *data++;
+			}
+			if (frame)
+			{
+				for (int i = 0; i < value; ++i)
+				{
+					frame->setPixelIterative(&x, &y, 0);
+				}
+			}
+		}
+		else if (frame)
+		{
+			frame->setPixelIterative(&x, &y, value);
+		}
+	}
+
+	if (frame)
+	{
+		// Unlock the surface
+		frame->unlock();
+	}
+	return data;
+}
+
+}
+
 /**
  * Sets up a new empty surface set for frames of the specified size.
  * @param width Frame width in pixels.
@@ -44,6 +115,8 @@ SurfaceSet::SurfaceSet(const SurfaceSet& other)
 	_width = other._width;
 	_height = other._height;
 	_sharedFrames = other._sharedFrames;
+	_pck = other._pck;
+	_pckFrames = other._pckFrames;
 
 	for (std::map<int, Surface*>::const_iterator f = other._frames.begin(); f != other._frames.end(); ++f)
 	{
@@ -69,27 +142,29 @@ SurfaceSet::~SurfaceSet()
  * frame in the image.
  * @param pck Filename of the PCK image.
  * @param tab Filename of the TAB offsets.
+ * @param packed Keep the frames compressed and only decode them
+ * the first time they're requested. The first frame is always
+ * decoded, the others take their palette from it.
  * @sa http://www.ufopaedia.org/index.php?title=Image_Formats#PCK
  */
-void SurfaceSet::loadPck(const std::string &pck, const std::string &tab)
+void SurfaceSet::loadPck(const std::string &pck, const std::string &tab, bool packed)
 {
 	int nframes = 0;
 
 	// Load TAB and get image offsets
 	if (!tab.empty())
 	{
-		std::ifstream offsetFile(tab.c_str(), std::ios::in | std::ios::binary);
+		MappedFile offsetFile(tab);
 		if (!offsetFile)
 		{
 			throw Exception(tab + " not found");
 		}
-		std::streampos begin, end;
-		begin = offsetFile.tellg();
-		int off;
-		offsetFile.read((char*)&off, sizeof(off));
-		offsetFile.seekg(0, std::ios::end);
-		end = offsetFile.tellg();
-		int size = end - begin;
+		int size = (int)offsetFile.getSize();
+		int off = 0;
+		if (size >= (int)sizeof(off))
+		{
+			memcpy(&off, offsetFile.getData(), sizeof(off));
+		}
 		// 16-bit offsets
 		if (off != 0)
 		{
@@ -100,10 +175,12 @@ void SurfaceSet::loadPck(const std::string &pck, const std::string &tab)
 		{
 			nframes = size / 4;
 		}
-		offsetFile.close();
 		for (int frame = 0; frame < nframes; ++frame)
 		{
-			_frames[frame] = new Surface(_width, _height);
+			if (!packed || frame == 0)
+			{
+				_frames[frame] = new Surface(_width, _height);
+			}
 		}
 	}
 	else
@@ -113,51 +190,57 @@ void SurfaceSet::loadPck(const std::string &pck, const std::string &tab)
 	}
 
 	// Load PCK and put pixels in surfaces
-	std::ifstream imgFile (pck.c_str(), std::ios::in | std::ios::binary);
+	MappedFile imgFile(pck);
 	if (!imgFile)
 	{
 		throw Exception(pck + " not found");
 	}
 
-	Uint8 value;
+	const Uint8 *start = imgFile.getData();
+	const Uint8 *data = start;
+	const Uint8 *end = data + imgFile.getSize();
+	Uint8 value = 0;
 
+	if (packed && nframes > 1)
+	{
+		// just note where each frame starts, getFrame() decodes them
+		_pck.assign(start, end);
+		_pckFrames.resize(nframes);
+	}
 	for (int frame = 0; frame < nframes; ++frame)
 	{
-		int x = 0, y = 0;
-
-		// Lock the surface
-		_frames[frame]->lock();
-
-		imgFile.read((char*)&value, 1);
-		for (int i = 0; i < value; ++i)
+		Surface *surface = 0;
+		if (_frames.find(frame) != _frames.end())
 		{
-			for (int j = 0; j < _width; ++j)
-			{
-				_frames[frame]->setPixelIterative(&x, &y, 0);
-			}
+			surface = _frames[frame];
 		}
-
-		while (imgFile.read((char*)&value, 1) && value != 255)
+		else
 		{
-			if (value == 254)
-			{
-				imgFile.read((char*)&value, 1);
-				for (int i = 0; i < value; ++i)
-				{
-					_frames[frame]->setPixelIterative(&x, &y, 0);
-				}
-			}
-			else
-			{
-				_frames[frame]->setPixelIterative(&x, &y, value);
-			}
+			_pckFrames[frame] = std::make_pair((size_t)(data - start), value);
 		}
-
-		// Unlock the surface
-		_frames[frame]->unlock();
+		data = decodePckFrame(surface, _width, data, end, value);
 	}
+}
 
-	imgFile.close();
+/**
+ * Decodes a frame that was left compressed by loadPck().
+ * @param i Frame number in the set.
+ * @return Pointer to the decoded frame, or 0 if there's no such frame.
+ */
+Surface *SurfaceSet::unpackFrame(int i)
+{
+	if (i <= 0 || (size_t)i >= _pckFrames.size())
+	{
+		return 0;
+	}
+	Surface *frame = new Surface(_width, _height);
+	// all frames get the same palette changes, so the first one has the current palette
+	frame->setPalette(_frames[0]->getPalette());
+	Uint8 value = _pckFrames[i].second;
+	const Uint8 *data = _pck.empty() ? 0 : &_pck[0];
+	decodePckFrame(frame, _width, data + _pckFrames[i].first, data + _pck.size(), value);
+	_frames[i] = frame;
+	return frame;
 }
 
 /**
@@ -173,15 +256,13 @@ void SurfaceSet::loadDat(const std::string &filename)
 	int nframes = 0;
 
 	// Load file and put pixels in surface
-	std::ifstream imgFile (filename.c_str(), std::ios::in | std::ios::binary);
+	MappedFile imgFile(filename);
 	if (!imgFile)
 	{
 		throw Exception(filename + " not found");
 	}
 
-	imgFile.seekg(0, std::ios::end);
-	std::streamoff size = imgFile.tellg();
-	imgFile.seekg(0, std::ios::beg);
+	size_t size = imgFile.getSize();
 
 	nframes = (int)size / (_width * _height);
 
@@ -191,15 +272,16 @@ void SurfaceSet::loadDat(const std::string &filename)
 		_frames[i] = surface;
 	}
 
-	Uint8 value;
+	const Uint8 *data = imgFile.getData();
+	const Uint8 *end = data + size;
 	int x = 0, y = 0, frame = 0;
 
 	// Lock the surface
 	_frames[frame]->lock();
 
-	while (imgFile.read((char*)&value, 1))
+	while (data != end)
 	{
-		_frames[frame]->setPixelIterative(&x, &y, value);
+		_frames[frame]->setPixelIterative(&x, &y, *data++);
 
 		if (y >= _height)
 		{
@@ -216,8 +298,6 @@ void SurfaceSet::loadDat(const std::string &filename)
 				_frames[frame]->lock();
 		}
 	}
-
-	imgFile.close();
 }
 
 /**
@@ -227,11 +307,12 @@ void SurfaceSet::loadDat(const std::string &filename)
  */
 Surface *SurfaceSet::getFrame(int i)
 {
-	if (_frames.find(i) != _frames.end())
+	std::map<int, Surface*>::const_iterator frame = _frames.find(i);
+	if (frame != _frames.end())
 	{
-		return _frames[i];
+		return frame->second;
 	}
-	return 0;
+	return unpackFrame(i);
 }
 
 /**
@@ -293,7 +374,7 @@ int SurfaceSet::getMaxSharedFrames() const
  */
 size_t SurfaceSet::getTotalFrames() const
 {
-	return _frames.size();
+	return std::max(_frames.size(), _pckFrames.size());
 }
 
 /**
@@ -310,8 +391,20 @@ void SurfaceSet::setPalette(SDL_Color *colors, int firstcolor, int ncolors)
 	}
 }
 
+/**
+ * Gets all the frames in the set, decoding any
+ * that are still compressed.
+ * @return Pointer to the frames.
+ */
 std::map<int, Surface*> *SurfaceSet::getFrames()
 {
+	for (size_t i = 1; i < _pckFrames.size(); ++i)
+	{
+		if (_frames.find(i) == _frames.end())
+		{
+			unpackFrame(i);
+		}
+	}
 	return &_frames;
 }
 
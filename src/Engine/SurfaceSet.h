@@ -19,6 +19,7 @@
  */
 #include <map>
 #include <string>
+#include <vector>
 #include <SDL.h>
 
 namespace OpenXcom
@@ -38,7 +39,11 @@ private:
 	std::map<int, Surface*> _frames;
 	int _width, _height;
 	int _sharedFrames;
+	std::vector<Uint8> _pck;
+	std::vector<std::pair<size_t, Uint8> > _pckFrames;
 
+	/// Decodes a frame that was left packed.
+	Surface *unpackFrame(int i);
 public:
 	/// Crates a surface set with frames of the specified size.
 	SurfaceSet(int width, int height);
@@ -47,7 +52,7 @@ public:
 	/// Cleans up the surface set.
 	~SurfaceSet();
 	/// Loads an X-Com set of PCK/TAB image files.
-	void loadPck(const std::string &pck, const std::string &tab = "");
+	void loadPck(const std::string &pck, const std::string &tab = "", bool packed = false);
 	/// Loads an X-Com DAT image file.
 	void loadDat(const std::string &filename);
 	/// Gets a particular frame from the set.
@@ -0,0 +1,431 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "CampaignSimulator.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <deque>
+#include <thread>
+#include <cstdio>
+#include "GeoscapeState.h"
+#include "../Engine/Game.h"
+#include "../Engine/Logger.h"
+#include "../Engine/CrossPlatform.h"
+#include "../Engine/Options.h"
+#include "../Engine/RNG.h"
+#include "../Mod/Mod.h"
+#include "../Mod/RuleCountry.h"
+#include "../Savegame/SavedGame.h"
+#include "../Savegame/GameTime.h"
+#include "../Savegame/Base.h"
+#include "../Savegame/Country.h"
+#include "../Savegame/AlienBase.h"
+#include "../fmath.h"
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#endif
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/**
+ * Outcome of a single simulated campaign, as printed
+ * by the process that ran it.
+ */
+struct CampaignResult
+{
+	uint64_t seed;
+	int months, ending, bases, alienBases, ufos;
+	int64_t funds;
+	double seconds;
+};
+
+/**
+ * Quotes a command-line argument for the shell, so it's
+ * passed on as is whatever characters it contains.
+ * @param arg Argument.
+ * @return Quoted argument.
+ */
+std::string quote(const std::string &arg)
+{
+#ifdef _WIN32
+	// backslashes are only special right before a quote
+	std::string quoted = "\"";
+	size_t backslashes = 0;
+	for (std::string::const_iterator i = arg.begin(); i != arg.end(); ++i)
+	{
+		if (*i == '\\')
+		{
+			backslashes++;
+		}
+		else
+		{
+			if (*i == '"')
+			{
+				quoted.append(backslashes + 1, '\\');
+			}
+			backslashes = 0;
+		}
+		quoted += *i;
+	}
+	quoted.append(backslashes, '\\');
+	return quoted + "\"";
+#else
+	// nothing is special inside single quotes, so only they need escaping
+	std::string quoted = "'";
+	for (std::string::const_iterator i = arg.begin(); i != arg.end(); ++i)
+	{
+		if (*i == '\'')
+		{
+			quoted += "'\\''";
+		}
+		else
+		{
+			quoted += *i;
+		}
+	}
+	return quoted + "'";
+#endif
+}
+
+/**
+ * Gets the file a campaign writes its outcome to. The game
+ * can't use its standard output on every platform, so the
+ * campaigns of a batch report back through files instead.
+ * @param seed Seed of the campaign.
+ * @return Path to the file.
+ */
+std::string getResultFile(uint64_t seed)
+{
+	std::ostringstream ss;
+	ss << Options::getUserFolder() << "simulate-" << seed << ".result";
+	return ss.str();
+}
+
+/**
+ * Reads the outcome of a campaign from the file it wrote.
+ * @param seed Seed of the campaign.
+ * @param result Outcome to fill in.
+ * @return True if the campaign wrote an outcome.
+ */
+bool readResult(uint64_t seed, CampaignResult &result)
+{
+	bool found = false;
+	std::ifstream file(getResultFile(seed).c_str());
+	std::string line;
+	while (std::getline(file, line))
+	{
+		std::istringstream ss(line);
+		std::string tag;
+		ss >> tag;
+		if (tag == "result")
+		{
+			ss >> result.seed >> result.months >> result.ending >> result.funds >> result.bases >> result.alienBases >> result.ufos >> result.seconds;
+			found = !ss.fail();
+		}
+	}
+	return found;
+}
+
+}
+
+/**
+ * Sets up a campaign simulator.
+ * @param game Pointer to the core game.
+ */
+CampaignSimulator::CampaignSimulator(Game *game) : _game(game), _geoscape(0), _idleSteps(0)
+{
+	for (int i = 0; i < TIME_STEPS; ++i)
+	{
+		_stepTime[i] = 0;
+		_stepCount[i] = 0;
+	}
+}
+
+/**
+ *
+ */
+CampaignSimulator::~CampaignSimulator()
+{
+}
+
+/**
+ * Loads the game data, starts a new campaign with a base
+ * and advances it until the given month or the campaign is over.
+ * @param months Number of months to simulate.
+ * @param seed Seed for the random number generator.
+ */
+void CampaignSimulator::run(int months, uint64_t seed)
+{
+	Log(LOG_INFO) << "Loading data...";
+	Options::updateMods();
+	_game->loadMods();
+	_game->loadLanguages();
+	Log(LOG_INFO) << "Data loaded successfully.";
+
+	RNG::setSeed(seed);
+	SavedGame *save = _game->getMod()->newSave();
+	_game->setSavedGame(save);
+
+	// put the first base where the first country's name is
+	Base *base = save->getBases()->back();
+	if (AreSame(base->getLongitude(), 0.0) && AreSame(base->getLatitude(), 0.0) && !save->getCountries()->empty())
+	{
+		base->setLongitude(save->getCountries()->front()->getRules()->getLabelLongitude());
+		base->setLatitude(save->getCountries()->front()->getRules()->getLabelLatitude());
+	}
+	base->setName("Simulation");
+
+	_geoscape = new GeoscapeState;
+	_game->setState(_geoscape);
+	_geoscape->init();
+	dismiss();
+
+	Log(LOG_INFO) << "Simulating " << months << " months with seed " << seed << "...";
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	while (save->getMonthsPassed() < months && save->getEnding() == END_NONE)
+	{
+		switch (save->getTime()->advance())
+		{
+		case TIME_1MONTH:
+			runStep(TIME_1MONTH);
+			reportMonth();
+		case TIME_1DAY:
+			runStep(TIME_1DAY);
+		case TIME_1HOUR:
+			runStep(TIME_1HOUR);
+		case TIME_30MIN:
+			runStep(TIME_30MIN);
+		case TIME_10MIN:
+			runStep(TIME_10MIN);
+		case TIME_5SEC:
+			runStep(TIME_5SEC);
+		}
+		dismiss();
+
+		int idle = _geoscape->getIdleSteps();
+		if (idle > 0)
+		{
+			_geoscape->skipIdleSteps(idle);
+			_idleSteps += idle;
+		}
+	}
+	double total = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	const char *names[TIME_STEPS] = { "5 seconds", "10 minutes", "30 minutes", "1 hour", "1 day", "1 month" };
+	Log(LOG_INFO) << "Simulation finished after " << save->getMonthsPassed() << " months in " << total << " s.";
+	for (int i = 0; i < TIME_STEPS; ++i)
+	{
+		double average = _stepCount[i] ? _stepTime[i] / _stepCount[i] * 1000000.0 : 0.0;
+		Log(LOG_INFO) << std::setw(10) << names[i] << ": " << _stepCount[i] << " steps, " << _stepTime[i] << " s, " << average << " us per step";
+	}
+	Log(LOG_INFO) << "Idle 5 second steps skipped: " << _idleSteps;
+	Log(LOG_INFO) << "Peak memory: " << CrossPlatform::getPeakMemory() / (1024 * 1024) << " MB";
+
+	std::ofstream file(getResultFile(seed).c_str());
+	file << "result " << seed << " " << save->getMonthsPassed() << " " << (int)save->getEnding() << " "
+		<< save->getFunds() << " " << save->getBases()->size() << " " << save->getAlienBases()->size() << " "
+		<< save->getUfos()->size() << " " << total << std::endl;
+}
+
+/**
+ * Runs a campaign for each seed in a range, each in its own
+ * process running this executable with the same arguments,
+ * and logs what the campaigns ended up like.
+ * @param argc Number of command-line arguments.
+ * @param argv Command-line arguments.
+ * @param months Number of months to simulate.
+ * @param seed First seed.
+ * @param runs Number of campaigns.
+ * @param jobs Number of campaigns at a time, or 0 for one per core.
+ */
+void CampaignSimulator::runBatch(int argc, char *argv[], int months, uint64_t seed, int runs, int jobs)
+{
+	if (jobs <= 0)
+	{
+		jobs = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	// pass on everything but the batch arguments
+	std::ostringstream command;
+	command << quote(argv[0]);
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		if ((arg == "-seed" || arg == "-runs" || arg == "-jobs" || arg == "--seed" || arg == "--runs" || arg == "--jobs") && i + 1 < argc)
+		{
+			++i;
+			continue;
+		}
+		command << " " << quote(arg);
+	}
+
+	Log(LOG_INFO) << "Simulating " << runs << " campaigns of " << months << " months from seed " << seed << ", " << jobs << " at a time...";
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::deque<std::pair<uint64_t, FILE*> > running;
+	std::vector<CampaignResult> results;
+	int next = 0;
+	while (next < runs || !running.empty())
+	{
+		while (next < runs && (int)running.size() < jobs)
+		{
+			remove(getResultFile(seed + next).c_str());
+			std::ostringstream run;
+			run << command.str() << " -seed " << seed + next << " -runs 1";
+#ifdef _WIN32
+			// cmd.exe strips the outer quotes of the whole line
+			FILE *pipe = popen(("\"" + run.str() + "\"").c_str(), "r");
+#else
+			FILE *pipe = popen(run.str().c_str(), "r");
+#endif
+			if (pipe)
+			{
+				running.push_back(std::make_pair(seed + next, pipe));
+			}
+			else
+			{
+				Log(LOG_ERROR) << "Couldn't start campaign " << seed + next;
+			}
+			++next;
+		}
+		if (running.empty())
+		{
+			continue;
+		}
+		// wait for the campaign to finish, throwing away anything it prints
+		char line[256];
+		while (fgets(line, sizeof(line), running.front().second))
+		{
+		}
+		pclose(running.front().second);
+		CampaignResult result;
+		if (readResult(running.front().first, result))
+		{
+			results.push_back(result);
+			Log(LOG_INFO) << "Campaign " << result.seed << ": " << result.months << " months, ending " << result.ending << ", " << result.funds << " funds";
+		}
+		else
+		{
+			Log(LOG_ERROR) << "Campaign " << running.front().first << " failed, see its log file";
+		}
+		running.pop_front();
+	}
+	double total = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	int endings[END_LOSE + 1] = {};
+	double totalMonths = 0, funds = 0, bases = 0, alienBases = 0, seconds = 0;
+	int64_t minFunds = 0, maxFunds = 0;
+	for (std::vector<CampaignResult>::iterator i = results.begin(); i != results.end(); ++i)
+	{
+		if (i->ending >= END_NONE && i->ending <= END_LOSE)
+		{
+			endings[i->ending]++;
+		}
+		totalMonths += i->months;
+		funds += i->funds;
+		bases += i->bases;
+		alienBases += i->alienBases;
+		seconds += i->seconds;
+		if (i == results.begin() || i->funds < minFunds)
+			minFunds = i->funds;
+		if (i == results.begin() || i->funds > maxFunds)
+			maxFunds = i->funds;
+	}
+	size_t n = std::max((size_t)1, results.size());
+	Log(LOG_INFO) << "Batch finished: " << results.size() << " of " << runs << " campaigns in " << total << " s.";
+	Log(LOG_INFO) << "Endings: " << endings[END_NONE] << " ongoing, " << endings[END_WIN] << " won, " << endings[END_LOSE] << " lost";
+	Log(LOG_INFO) << "Average months: " << totalMonths / n << ", bases: " << bases / n << ", alien bases: " << alienBases / n;
+	Log(LOG_INFO) << "Funds: average " << (int64_t)(funds / n) << ", min " << minFunds << ", max " << maxFunds;
+	Log(LOG_INFO) << "Average time per campaign: " << seconds / n << " s";
+}
+
+/**
+ * Runs and times the geoscape logic for a kind of time step.
+ * @param step Time trigger to run.
+ */
+void CampaignSimulator::runStep(int step)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	switch (step)
+	{
+	case TIME_1MONTH:
+		_geoscape->time1Month();
+		break;
+	case TIME_1DAY:
+		_geoscape->time1Day();
+		break;
+	case TIME_1HOUR:
+		_geoscape->time1Hour();
+		break;
+	case TIME_30MIN:
+		_geoscape->time30Minutes();
+		break;
+	case TIME_10MIN:
+		_geoscape->time10Minutes();
+		break;
+	case TIME_5SEC:
+		_geoscape->time5Seconds();
+		break;
+	}
+	_stepTime[step] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	_stepCount[step]++;
+}
+
+/**
+ * Throws away the popups and screens the geoscape opened
+ * since there's nobody to answer them, and skips any
+ * battle that was about to start.
+ */
+void CampaignSimulator::dismiss()
+{
+	_geoscape->dismissPopups();
+	while (!_game->isState(_geoscape))
+	{
+		_game->popState();
+	}
+	_game->deleteStates();
+	if (_game->getSavedGame()->getSavedBattle())
+	{
+		_game->getSavedGame()->setBattleGame(0);
+	}
+}
+
+/**
+ * Logs the counts of things on the globe at the end of a month.
+ */
+void CampaignSimulator::reportMonth() const
+{
+	SavedGame *save = _game->getSavedGame();
+	Log(LOG_INFO) << "Month " << save->getMonthsPassed() << ": "
+		<< save->getUfos()->size() << " UFOs, "
+		<< save->getAlienMissions().size() << " alien missions, "
+		<< save->getAlienBases()->size() << " alien bases, "
+		<< save->getMissionSites()->size() << " mission sites, "
+		<< save->getBases()->size() << " bases, "
+		<< save->getFunds() << " funds";
+}
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <stdint.h>
+
+namespace OpenXcom
+{
+
+class Game;
+class GeoscapeState;
+
+/**
+ * Runs a new campaign without a player, advancing the
+ * geoscape as fast as possible for a number of months
+ * and reporting how long each kind of time step took.
+ * Popups are dismissed and battles are skipped.
+ * Batches of seeds run in separate processes, since the
+ * options, rulesets and game are global to the process.
+ */
+class CampaignSimulator
+{
+private:
+	static const int TIME_STEPS = 6;
+	Game *_game;
+	GeoscapeState *_geoscape;
+	double _stepTime[TIME_STEPS];
+	size_t _stepCount[TIME_STEPS];
+	size_t _idleSteps;
+
+	/// Runs the geoscape logic for a time step.
+	void runStep(int step);
+	/// Throws away anything waiting on the player.
+	void dismiss();
+	/// Logs the state of the campaign.
+	void reportMonth() const;
+public:
+	/// Creates a campaign simulator.
+	CampaignSimulator(Game *game);
+	/// Cleans up the campaign simulator.
+	~CampaignSimulator();
+	/// Runs the campaign for some months.
+	void run(int months, uint64_t seed);
+	/// Runs many campaigns in parallel and sums up the outcomes.
+	static void runBatch(int argc, char *argv[], int months, uint64_t seed, int runs, int jobs);
+};
+
+}
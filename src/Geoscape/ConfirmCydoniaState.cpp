@@ -24,7 +24,7 @@
 #include "../Interface/Text.h"
 #include "../Interface/TextButton.h"
 #include "../Battlescape/BattlescapeGenerator.h"
-#include "../Battlescape/BriefingState.h"
+#include "../Battlescape/GenerateBattleState.h"
 #include "../Savegame/SavedBattleGame.h"
 #include "../Savegame/SavedGame.h"
 #include "../Mod/AlienDeployment.h"
@@ -87,22 +87,19 @@ void ConfirmCydoniaState::btnYesClick(Action *)
 	_game->popState();
 
 	SavedBattleGame *bgame = new SavedBattleGame();
-	_game->getSavedGame()->setBattleGame(bgame);
-	BattlescapeGenerator bgen = BattlescapeGenerator(_game);
+	BattlescapeGenerator *bgen = new BattlescapeGenerator(_game, bgame);
 	for (std::vector<std::string>::const_iterator i = _game->getMod()->getDeploymentsList().begin(); i != _game->getMod()->getDeploymentsList().end(); ++i)
 	{
 		AlienDeployment *deployment = _game->getMod()->getDeployment(*i);
 		if (deployment->isFinalDestination())
 		{
 			bgame->setMissionType(*i);
-			bgen.setAlienRace(deployment->getRace());
+			bgen->setAlienRace(deployment->getRace());
 			break;
 		}
 	}
-	bgen.setCraft(_craft);
-	bgen.run();
-
-	_game->pushState(new BriefingState(_craft));
+	bgen->setCraft(_craft);
+	_game->pushState(new GenerateBattleState(bgen, bgame, _craft));
 
 }
 
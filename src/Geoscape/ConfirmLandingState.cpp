@@ -32,7 +32,7 @@
 #include "../Savegame/Base.h"
 #include "../Savegame/MissionSite.h"
 #include "../Savegame/AlienBase.h"
-#include "../Battlescape/BriefingState.h"
+#include "../Battlescape/GenerateBattleState.h"
 #include "../Battlescape/BattlescapeGenerator.h"
 #include "../Engine/Exception.h"
 #include "../Engine/Options.h"
@@ -124,41 +124,39 @@ void ConfirmLandingState::btnYesClick(Action *)
 	Ufo* u = dynamic_cast<Ufo*>(_craft->getDestination());
 	MissionSite* m = dynamic_cast<MissionSite*>(_craft->getDestination());
 	AlienBase* b = dynamic_cast<AlienBase*>(_craft->getDestination());
+	if (u == 0 && m == 0 && b == 0)
+	{
+		throw Exception("No mission available!");
+	}
 
 	SavedBattleGame *bgame = new SavedBattleGame();
-	_game->getSavedGame()->setBattleGame(bgame);
-	BattlescapeGenerator bgen(_game);
-	bgen.setWorldTexture(_texture);
-	bgen.setWorldShade(_shade);
-	bgen.setCraft(_craft);
+	BattlescapeGenerator *bgen = new BattlescapeGenerator(_game, bgame);
+	bgen->setWorldTexture(_texture);
+	bgen->setWorldShade(_shade);
+	bgen->setCraft(_craft);
 	if (u != 0)
 	{
 		if (u->getStatus() == Ufo::CRASHED)
 			bgame->setMissionType("STR_UFO_CRASH_RECOVERY");
 		else
 			bgame->setMissionType("STR_UFO_GROUND_ASSAULT");
-		bgen.setUfo(u);
-		bgen.setAlienRace(u->getAlienRace());
+		bgen->setUfo(u);
+		bgen->setAlienRace(u->getAlienRace());
 	}
 	else if (m != 0)
 	{
 		bgame->setMissionType(m->getDeployment()->getType());
-		bgen.setMissionSite(m);
-		bgen.setAlienRace(m->getAlienRace());
-	}
-	else if (b != 0)
-	{
-		bgame->setMissionType(b->getDeployment()->getType());
-		bgen.setAlienBase(b);
-		bgen.setAlienRace(b->getAlienRace());
-		bgen.setWorldTexture(0);
+		bgen->setMissionSite(m);
+		bgen->setAlienRace(m->getAlienRace());
 	}
 	else
 	{
-		throw Exception("No mission available!");
+		bgame->setMissionType(b->getDeployment()->getType());
+		bgen->setAlienBase(b);
+		bgen->setAlienRace(b->getAlienRace());
+		bgen->setWorldTexture(0);
 	}
-	bgen.run();
-	_game->pushState(new BriefingState(_craft));
+	_game->pushState(new GenerateBattleState(bgen, bgame, _craft));
 }
 
 /**
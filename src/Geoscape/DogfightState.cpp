@@ -581,7 +581,10 @@ void DogfightState::think()
 	if (!_endDogfight)
 	{
 		update();
-		_craftDamageAnimTimer->think(this, 0);
+		if (!_minimized)
+		{
+			_craftDamageAnimTimer->think(this, 0);
+		}
 	}
 	if (!_craft->isInDogfight() || _craft->getDestination() != _ufo || _ufo->getStatus() == Ufo::LANDED)
 	{
@@ -1303,6 +1306,11 @@ void DogfightState::maximumDistance()
  */
 void DogfightState::setStatus(const std::string &status)
 {
+	// hidden while minimized, no point laying out the text every tick
+	if (_minimized)
+	{
+		return;
+	}
 	_txtStatus->setText(tr(status));
 	_timeout = 50;
 }
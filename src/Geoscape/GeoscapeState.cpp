@@ -92,7 +92,7 @@
 #include "../Savegame/AlienMission.h"
 #include "../Savegame/SavedBattleGame.h"
 #include "../Battlescape/BattlescapeGenerator.h"
-#include "../Battlescape/BriefingState.h"
+#include "../Battlescape/GenerateBattleState.h"
 #include "../Mod/UfoTrajectory.h"
 #include "../Mod/Armor.h"
 #include "BaseDefenseState.h"
@@ -499,6 +499,7 @@ void GeoscapeState::handle(Action *action)
 void GeoscapeState::init()
 {
 	State::init();
+	RNG::setStream(RNG::STREAM_GEOSCAPE);
 	timeDisplay();
 
 	_globe->onMouseClick((ActionHandler)&GeoscapeState::globeClick);
@@ -676,6 +677,13 @@ void GeoscapeState::timeAdvance()
 		case TIME_5SEC:
 			time5Seconds();
 		}
+
+		int idle = std::min(timeSpan - i - 1, getIdleSteps());
+		if (idle > 0)
+		{
+			skipIdleSteps(idle);
+			i += idle;
+		}
 	}
 
 	_pause = !_dogfightsToBeStarted.empty() || _zoomInEffectTimer->isRunning() || _zoomOutEffectTimer->isRunning();
@@ -1031,6 +1039,69 @@ void GeoscapeState::time5Seconds()
 	}
 }
 
+/**
+ * Works out how many of the following 5 second steps
+ * can't change anything: no UFOs or craft are moving,
+ * no dogfights are going on, and no landed UFO takes
+ * off before the next 10 minute trigger.
+ * @return Number of steps that can be skipped.
+ */
+int GeoscapeState::getIdleSteps() const
+{
+	SavedGame *save = _game->getSavedGame();
+	if (_pause || !_dogfights.empty() || !_dogfightsToBeStarted.empty() || save->getEnding() == END_LOSE)
+	{
+		return 0;
+	}
+	int steps = save->getTime()->getStepsTo10Minutes() - 1;
+	for (std::vector<Ufo*>::const_iterator i = save->getUfos()->begin(); i != save->getUfos()->end() && steps > 0; ++i)
+	{
+		switch ((*i)->getStatus())
+		{
+		case Ufo::LANDED:
+			steps = std::min(steps, (int)(*i)->getSecondsRemaining() / 5 - 1);
+			break;
+		case Ufo::CRASHED:
+			if ((*i)->getSecondsRemaining() == 0)
+				return 0;
+			break;
+		default:
+			return 0;
+		}
+	}
+	for (std::vector<Base*>::const_iterator i = save->getBases()->begin(); i != save->getBases()->end() && steps > 0; ++i)
+	{
+		for (std::vector<Craft*>::const_iterator j = (*i)->getCrafts()->begin(); j != (*i)->getCrafts()->end(); ++j)
+		{
+			if (!(*j)->isIdle() || (*j)->isDestroyed())
+				return 0;
+		}
+	}
+	return std::max(0, steps);
+}
+
+/**
+ * Advances the time over steps where nothing happens,
+ * counting down the landed UFOs the same as
+ * time5Seconds() would.
+ * @param steps Number of steps, from getIdleSteps().
+ */
+void GeoscapeState::skipIdleSteps(int steps)
+{
+	SavedGame *save = _game->getSavedGame();
+	for (int i = 0; i < steps; ++i)
+	{
+		save->getTime()->advance();
+	}
+	for (std::vector<Ufo*>::iterator i = save->getUfos()->begin(); i != save->getUfos()->end(); ++i)
+	{
+		if ((*i)->getStatus() == Ufo::LANDED)
+		{
+			(*i)->setSecondsRemaining((*i)->getSecondsRemaining() - steps * 5);
+		}
+	}
+}
+
 /**
  * Functor that attempt to detect an XCOM base.
  */
@@ -1653,7 +1724,7 @@ void GeoscapeState::time1Day()
 				{
 					if (research->getName() == (*iter2)->getRules()->getName())
 					{
-						if (!_game->getSavedGame()->isResearched(research->getGetOneFree(), false))
+						if (!_game->getSavedGame()->isResearched(research->getGetOneFreeRules(), false))
 						{
 							// This research topic still has some more undiscovered "getOneFree" topics, keep it!
 						}
@@ -1806,6 +1877,20 @@ void GeoscapeState::popup(State *state)
 	_popups.push_back(state);
 }
 
+/**
+ * Throws away the popup windows waiting to be shown
+ * and resumes the game, without showing them.
+ */
+void GeoscapeState::dismissPopups()
+{
+	for (std::list<State*>::iterator i = _popups.begin(); i != _popups.end(); ++i)
+	{
+		delete *i;
+	}
+	_popups.clear();
+	_pause = false;
+}
+
 /**
  * Returns a pointer to the Geoscape globe for
  * access by other substates.
@@ -2212,14 +2297,12 @@ void GeoscapeState::handleBaseDefense(Base *base, Ufo *ufo)
 	if (base->getAvailableSoldiers(true) > 0 || !base->getVehicles()->empty())
 	{
 		SavedBattleGame *bgame = new SavedBattleGame();
-		_game->getSavedGame()->setBattleGame(bgame);
 		bgame->setMissionType("STR_BASE_DEFENSE");
-		BattlescapeGenerator bgen = BattlescapeGenerator(_game);
-		bgen.setBase(base);
-		bgen.setAlienRace(ufo->getAlienRace());
-		bgen.run();
+		BattlescapeGenerator *bgen = new BattlescapeGenerator(_game, bgame);
+		bgen->setBase(base);
+		bgen->setAlienRace(ufo->getAlienRace());
 		_pause = true;
-		_game->pushState(new BriefingState(0, base));
+		_game->pushState(new GenerateBattleState(bgen, bgame, 0, base));
 	}
 	else
 	{
@@ -73,6 +73,10 @@ public:
 	void timeAdvance();
 	/// Trigger whenever 5 seconds pass.
 	void time5Seconds();
+	/// Gets the upcoming 5 second steps where nothing happens.
+	int getIdleSteps() const;
+	/// Skips 5 second steps where nothing happens.
+	void skipIdleSteps(int steps);
 	/// Trigger whenever 10 minutes pass.
 	void time10Minutes();
 	/// Trigger whenever 30 minutes pass.
@@ -87,6 +91,8 @@ public:
 	void timerReset();
 	/// Displays a popup window.
 	void popup(State *state);
+	/// Discards the popup windows waiting to be shown.
+	void dismissPopups();
 	/// Gets the Geoscape globe.
 	Globe *getGlobe() const;
 	/// Handler for clicking the globe.
@@ -393,48 +393,15 @@ bool Globe::pointBack(double lon, double lat) const
 	return c < 0.0;
 }
 
+/**
+ * Gets the world polygon at a polar point.
+ * @param lon Longitude of the point.
+ * @param lat Latitude of the point.
+ * @return Pointer to the polygon, or NULL if it's on water.
+ */
 Polygon* Globe::getPolygonFromLonLat(double lon, double lat) const
 {
-	const double zDiscard=0.75f;
-	double coslat = cos(lat);
-	double sinlat = sin(lat);
-
-	for (std::list<Polygon*>::iterator i = _rules->getPolygons()->begin(); i != _rules->getPolygons()->end(); ++i)
-	{
-		double x, y, z, x2, y2;
-		double clat, clon;
-		z = 0;
-		for (int j = 0; j < (*i)->getPoints(); ++j)
-		{
-			z = coslat * cos((*i)->getLatitude(j)) * cos((*i)->getLongitude(j) - lon) + sinlat * sin((*i)->getLatitude(j));
-			if (z<zDiscard) break; //discarded
-		}
-		if (z<zDiscard) continue; //discarded
-
-		bool odd = false;
-
-		clat = (*i)->getLatitude(0); //initial point
-		clon = (*i)->getLongitude(0);
-		x = cos(clat) * sin(clon - lon);
-		y = coslat * sin(clat) - sinlat * cos(clat) * cos(clon - lon);
-
-		for (int j = 0; j < (*i)->getPoints(); ++j)
-		{
-			int k = (j + 1) % (*i)->getPoints(); //index of next point in poly
-			clat = (*i)->getLatitude(k);
-			clon = (*i)->getLongitude(k);
-
-			x2 = cos(clat) * sin(clon - lon);
-			y2 = coslat * sin(clat) - sinlat * cos(clat) * cos(clon - lon);
-			if ( ((y>0)!=(y2>0)) && (0 < (x2-x)*(0-y)/(y2-y)+x) )
-				odd = !odd;
-			x = x2;
-			y = y2;
-
-		}
-		if (odd) return *i;
-	}
-	return NULL;
+	return _rules->getPolygonFromLonLat(lon, lat);
 }
 
 /**
@@ -723,13 +723,23 @@ void GraphsState::drawCountryLines()
 	range = upperLimit - lowerLimit;
 	double units = range / 126;
 
+	// the data can't change while the graphs are open, so the lines
+	// only need drawing again if the scale changed
+	std::vector<Surface *> &lines = _alien ? _alienCountryLines : (_income ? _incomeLines : _xcomCountryLines);
+	std::pair<int, int> &scale = _alien ? _alienCountryScale : (_income ? _incomeScale : _xcomCountryScale);
+	bool redraw = (scale != std::make_pair(lowerLimit, upperLimit));
+	scale = std::make_pair(lowerLimit, upperLimit);
+
 	// draw country lines
 	for (size_t entry = 0; entry != _game->getSavedGame()->getCountries()->size(); ++entry)
 	{
+		lines.at(entry)->setVisible(_countryToggles.at(entry)->_pushed);
+		if (!redraw)
+		{
+			continue;
+		}
 		Country *country = _game->getSavedGame()->getCountries()->at(entry);
-		_alienCountryLines.at(entry)->clear();
-		_xcomCountryLines.at(entry)->clear();
-		_incomeLines.at(entry)->clear();
+		lines.at(entry)->clear();
 		std::vector<Sint16> newLineVector;
 		int reduction = 0;
 		for (size_t iter = 0; iter != 12; ++iter)
@@ -766,54 +776,32 @@ void GraphsState::drawCountryLines()
 			if (y >=175)
 				y = 175;
 			newLineVector.push_back(y);
-			if (newLineVector.size() > 1 && _alien)
-				_alienCountryLines.at(entry)->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), _countryToggles.at(entry)->_color+4);
-			else if (newLineVector.size() > 1 && _income)
-				_incomeLines.at(entry)->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), _countryToggles.at(entry)->_color+4);
-			else if (newLineVector.size() > 1)
-				_xcomCountryLines.at(entry)->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), _countryToggles.at(entry)->_color+4);
-			}
-		if (_alien)
-			_alienCountryLines.at(entry)->setVisible(_countryToggles.at(entry)->_pushed);
-		else if (_income)
-			_incomeLines.at(entry)->setVisible(_countryToggles.at(entry)->_pushed);
-		else
-			_xcomCountryLines.at(entry)->setVisible(_countryToggles.at(entry)->_pushed);
+			if (newLineVector.size() > 1)
+				lines.at(entry)->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), _countryToggles.at(entry)->_color+4);
+		}
 	}
-	if (_alien)
-		_alienCountryLines.back()->clear();
-	else if (_income)
-		_incomeLines.back()->clear();
-	else
-		_xcomCountryLines.back()->clear();
 
 	// set up the "total" line
-	std::vector<Sint16> newLineVector;
-	Uint8 color = _game->getMod()->getInterface("graphs")->getElement("countryTotal")->color2;
-	for (int iter = 0; iter != 12; ++iter)
+	if (redraw)
 	{
-		int x = 312 - (iter*17);
-		int y = 175 - (-lowerLimit / units);
-		int reduction = totals[iter] / units;
-		y -= reduction;
-
-		newLineVector.push_back(y);
-		if (newLineVector.size() > 1)
+		lines.back()->clear();
+		std::vector<Sint16> newLineVector;
+		Uint8 color = _game->getMod()->getInterface("graphs")->getElement("countryTotal")->color2;
+		for (int iter = 0; iter != 12; ++iter)
 		{
-			if (_alien)
-				_alienCountryLines.back()->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), color);
-			else if (_income)
-				_incomeLines.back()->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), color);
-			else
-				_xcomCountryLines.back()->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), color);
+			int x = 312 - (iter*17);
+			int y = 175 - (-lowerLimit / units);
+			int reduction = totals[iter] / units;
+			y -= reduction;
+
+			newLineVector.push_back(y);
+			if (newLineVector.size() > 1)
+			{
+				lines.back()->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), color);
+			}
 		}
 	}
-	if (_alien)
-		_alienCountryLines.back()->setVisible(_countryToggles.back()->_pushed);
-	else if (_income)
-		_incomeLines.back()->setVisible(_countryToggles.back()->_pushed);
-	else
-		_xcomCountryLines.back()->setVisible(_countryToggles.back()->_pushed);
+	lines.back()->setVisible(_countryToggles.back()->_pushed);
 	updateScale(lowerLimit, upperLimit);
 	_txtFactor->setVisible(_income);
 }
@@ -890,12 +878,23 @@ void GraphsState::drawRegionLines()
 	}
 	range = upperLimit - lowerLimit;
 	double units = range / 126;
+	// the data can't change while the graphs are open, so the lines
+	// only need drawing again if the scale changed
+	std::vector<Surface *> &lines = _alien ? _alienRegionLines : _xcomRegionLines;
+	std::pair<int, int> &scale = _alien ? _alienRegionScale : _xcomRegionScale;
+	bool redraw = (scale != std::make_pair(lowerLimit, upperLimit));
+	scale = std::make_pair(lowerLimit, upperLimit);
+
 	// draw region lines
 	for (size_t entry = 0; entry != _game->getSavedGame()->getRegions()->size(); ++entry)
 	{
+		lines.at(entry)->setVisible(_regionToggles.at(entry)->_pushed);
+		if (!redraw)
+		{
+			continue;
+		}
 		Region *region = _game->getSavedGame()->getRegions()->at(entry);
-		_alienRegionLines.at(entry)->clear();
-		_xcomRegionLines.at(entry)->clear();
+		lines.at(entry)->clear();
 		std::vector<Sint16> newLineVector;
 		int reduction = 0;
 		for (size_t iter = 0; iter != 12; ++iter)
@@ -923,46 +922,32 @@ void GraphsState::drawRegionLines()
 			if (y >=175)
 				y = 175;
 			newLineVector.push_back(y);
-			if (newLineVector.size() > 1 && _alien)
-				_alienRegionLines.at(entry)->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), _regionToggles.at(entry)->_color+4);
-			else if (newLineVector.size() > 1)
-				_xcomRegionLines.at(entry)->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), _regionToggles.at(entry)->_color+4);
+			if (newLineVector.size() > 1)
+				lines.at(entry)->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), _regionToggles.at(entry)->_color+4);
 		}
-
-		if (_alien)
-			_alienRegionLines.at(entry)->setVisible(_regionToggles.at(entry)->_pushed);
-		else
-			_xcomRegionLines.at(entry)->setVisible(_regionToggles.at(entry)->_pushed);
 	}
 
 	// set up the "total" line
-	if (_alien)
-		_alienRegionLines.back()->clear();
-	else
-		_xcomRegionLines.back()->clear();
-
-	Uint8 color = _game->getMod()->getInterface("graphs")->getElement("regionTotal")->color2;
-	std::vector<Sint16> newLineVector;
-	for (int iter = 0; iter != 12; ++iter)
+	if (redraw)
 	{
-		int x = 312 - (iter*17);
-		int y = 175 - (-lowerLimit / units);
-		int reduction = totals[iter] / units;
-		y -= reduction;
-
-		newLineVector.push_back(y);
-		if (newLineVector.size() > 1)
+		lines.back()->clear();
+		Uint8 color = _game->getMod()->getInterface("graphs")->getElement("regionTotal")->color2;
+		std::vector<Sint16> newLineVector;
+		for (int iter = 0; iter != 12; ++iter)
 		{
-			if (_alien)
-				_alienRegionLines.back()->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), color);
-			else
-				_xcomRegionLines.back()->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), color);
+			int x = 312 - (iter*17);
+			int y = 175 - (-lowerLimit / units);
+			int reduction = totals[iter] / units;
+			y -= reduction;
+
+			newLineVector.push_back(y);
+			if (newLineVector.size() > 1)
+			{
+				lines.back()->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), color);
+			}
 		}
 	}
-	if (_alien)
-		_alienRegionLines.back()->setVisible(_regionToggles.back()->_pushed);
-	else
-		_xcomRegionLines.back()->setVisible(_regionToggles.back()->_pushed);
+	lines.back()->setVisible(_regionToggles.back()->_pushed);
 	updateScale(lowerLimit, upperLimit);
 	_txtFactor->setVisible(false);
 }
@@ -1071,13 +1056,16 @@ void GraphsState::drawFinanceLines()
 	for (int button = 0; button != 5; ++button)
 	{
 		_financeLines.at(button)->setVisible(_financeToggles.at(button));
-		_financeLines.at(button)->clear();
 	}
+	// the lines only need drawing again if the scale changed
+	bool redraw = (_financeScale != std::make_pair(lowerLimit, upperLimit));
+	_financeScale = std::make_pair(lowerLimit, upperLimit);
 	range = upperLimit - lowerLimit;
 	//figure out how many units to the pixel, then plot the points for the graph and connect the dots.
 	double units = range / 126;
-	for (int button = 0; button != 5; ++button)
+	for (int button = 0; button != 5 && redraw; ++button)
 	{
+		_financeLines.at(button)->clear();
 		std::vector<Sint16> newLineVector;
 		for (int iter = 0; iter != 12; ++iter)
 		{
@@ -18,6 +18,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "../Engine/State.h"
+#include <utility>
 
 namespace OpenXcom
 {
@@ -53,6 +54,8 @@ private:
 	std::vector<Surface *> _alienRegionLines, _alienCountryLines;
 	std::vector<Surface *> _xcomRegionLines, _xcomCountryLines;
 	std::vector<Surface *> _financeLines, _incomeLines;
+	std::pair<int, int> _alienRegionScale, _alienCountryScale, _xcomRegionScale, _xcomCountryScale;
+	std::pair<int, int> _financeScale, _incomeScale;
 	bool _alien, _income, _country, _finance;
 	static const size_t GRAPH_MAX_BUTTONS=16;
 	//will be only between 0 and size()
@@ -66,6 +66,8 @@ public:
 	int getSubY() const;
 	/// Has this sprite been loaded?
 	bool isLoaded() const;
+	/// Marks this sprite as not loaded.
+	void unload();
 	/// Checks if a filename is a valid image file.
 	static bool isImageFile(const std::string &filename);
 	/// Load the external sprite into a surface.
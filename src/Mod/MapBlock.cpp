@@ -21,6 +21,9 @@
 #include <algorithm>
 #include "../Battlescape/Position.h"
 #include "../Engine/Exception.h"
+#include "../Engine/FileMap.h"
+#include "../Engine/MappedFile.h"
+#include "../Engine/Logger.h"
 
 namespace OpenXcom
 {
@@ -28,7 +31,8 @@ namespace OpenXcom
 /**
  * MapBlock construction.
  */
-MapBlock::MapBlock(const std::string &name): _name(name), _size_x(10), _size_y(10), _size_z(4)
+MapBlock::MapBlock(const std::string &name): _name(name), _size_x(10), _size_y(10), _size_z(4),
+	_mapSizeX(0), _mapSizeY(0), _mapSizeZ(0), _mapCached(false), _routesCached(false)
 {
 	_groups.push_back(0);
 }
@@ -81,6 +85,11 @@ void MapBlock::load(const YAML::Node &node)
 		}
 	}
 	_items = node["items"].as< std::map<std::string, std::vector<Position> > >(_items);
+	// the name might point at different files now
+	_mapCached = false;
+	_routesCached = false;
+	_mapRecords.clear();
+	_routeRecords.clear();
 }
 
 /**
@@ -154,4 +163,114 @@ std::map<std::string, std::vector<Position> > *MapBlock::getItems()
 	return &_items;
 }
 
+
+/**
+ * Reads the MAP file of this block into memory, so later
+ * missions don't have to open and parse it again.
+ * @return False if the file doesn't exist.
+ */
+bool MapBlock::cacheMap()
+{
+	std::string filename = "MAPS/" + _name + ".MAP";
+	MappedFile mapFile(FileMap::getFilePath(filename));
+	if (!mapFile)
+	{
+		return false;
+	}
+	if (mapFile.getSize() < 3)
+	{
+		throw Exception("Invalid MAP file: " + filename);
+	}
+
+	const unsigned char *data = mapFile.getData();
+	_mapSizeY = (int)(char)data[0];
+	_mapSizeX = (int)(char)data[1];
+	_mapSizeZ = (int)(char)data[2];
+	// four bytes per tile: floor, west wall, north wall, object.
+	// a truncated record at the end is ignored.
+	size_t records = (mapFile.getSize() - 3) / 4;
+	_mapRecords.assign(data + 3, data + 3 + records * 4);
+	_mapCached = true;
+	return true;
+}
+
+/**
+ * Reads the RMP file of this block into memory, so later
+ * missions don't have to open and parse it again.
+ * @return False if the file doesn't exist.
+ */
+bool MapBlock::cacheRoutes()
+{
+	std::string filename = "ROUTES/" + _name + ".RMP";
+	MappedFile routeFile(FileMap::getFilePath(filename));
+	if (!routeFile)
+	{
+		return false;
+	}
+
+	// 24 bytes per node, a truncated record at the end is ignored.
+	size_t records = routeFile.getSize() / 24;
+	_routeRecords.assign(routeFile.getData(), routeFile.getData() + records * 24);
+	_routesCached = true;
+	return true;
+}
+
+/**
+ * Reads the MAP and RMP files of this block ahead of time.
+ * Missing or broken files are left for the battlescape
+ * generator to report when the block actually gets used.
+ */
+void MapBlock::preload()
+{
+	try
+	{
+		if (!_mapCached)
+		{
+			cacheMap();
+		}
+		if (!_routesCached)
+		{
+			cacheRoutes();
+		}
+	}
+	catch (Exception &e)
+	{
+		Log(LOG_WARNING) << e.what();
+	}
+}
+
+/**
+ * Gets the tile records of this block's MAP file, four bytes
+ * per tile, in the order they're stored in the file.
+ * @param sizeX Returns the width stored in the file.
+ * @param sizeY Returns the length stored in the file.
+ * @param sizeZ Returns the height stored in the file.
+ * @return The tile records.
+ */
+const std::vector<unsigned char> &MapBlock::getMapRecords(int *sizeX, int *sizeY, int *sizeZ)
+{
+	if (!_mapCached && !cacheMap())
+	{
+		throw Exception("MAPS/" + _name + ".MAP not found");
+	}
+	*sizeX = _mapSizeX;
+	*sizeY = _mapSizeY;
+	*sizeZ = _mapSizeZ;
+	return _mapRecords;
+}
+
+/**
+ * Gets the node records of this block's RMP file,
+ * 24 bytes per node.
+ * @return The node records.
+ */
+const std::vector<unsigned char> &MapBlock::getRouteRecords()
+{
+	if (!_routesCached && !cacheRoutes())
+	{
+		throw Exception("ROUTES/" + _name + ".RMP not found");
+	}
+	return _routeRecords;
+}
+
 }
@@ -41,6 +41,13 @@ private:
 	int _size_x, _size_y, _size_z;
 	std::vector<int> _groups, _revealedFloors;
 	std::map<std::string, std::vector<Position> > _items;
+	int _mapSizeX, _mapSizeY, _mapSizeZ;
+	std::vector<unsigned char> _mapRecords, _routeRecords;
+	bool _mapCached, _routesCached;
+	/// Reads the MAP file into the cache.
+	bool cacheMap();
+	/// Reads the RMP file into the cache.
+	bool cacheRoutes();
 public:
 	MapBlock(const std::string &name);
 	~MapBlock();
@@ -62,6 +69,12 @@ public:
 	bool isFloorRevealed(int floor);
 	/// Gets the layout for any items that belong in this map block.
 	std::map<std::string, std::vector<Position> > *getItems();
+	/// Reads the MAP and RMP files ahead of time.
+	void preload();
+	/// Gets the tile records of the MAP file.
+	const std::vector<unsigned char> &getMapRecords(int *sizeX, int *sizeY, int *sizeZ);
+	/// Gets the node records of the RMP file.
+	const std::vector<unsigned char> &getRouteRecords();
 
 };
 
@@ -25,17 +25,21 @@
 #include "../Engine/SurfaceSet.h"
 #include "../Engine/FileMap.h"
 #include "../Engine/Logger.h"
+#include "../Engine/Options.h"
+#include <algorithm>
 
 namespace OpenXcom
 {
 
 MapData *MapDataSet::_blankTile = 0;
 MapData *MapDataSet::_scorchedTile = 0;
+std::list<MapDataSet*> MapDataSet::_idle;
+size_t MapDataSet::_idleBytes = 0;
 
 /**
  * MapDataSet construction.
  */
-MapDataSet::MapDataSet(const std::string &name) : _name(name), _surfaceSet(0), _loaded(false)
+MapDataSet::MapDataSet(const std::string &name) : _name(name), _surfaceSet(0), _loaded(false), _references(0), _bytes(0)
 {
 }
 
@@ -91,11 +95,19 @@ SurfaceSet *MapDataSet::getSurfaceset() const
 }
 
 /**
- * Loads terrain data in XCom format (MCD & PCK files).
+ * Loads terrain data in XCom format (MCD & PCK files), and counts
+ * one more battle using it. Data no battle uses anymore is kept
+ * around for the next one, see release().
  * @sa http://www.ufopaedia.org/index.php?title=MCD
  */
 void MapDataSet::loadData(MCDPatch *patch)
 {
+	if (_references++ == 0 && _loaded)
+	{
+		// picked up again before it got unloaded
+		_idle.remove(this);
+		_idleBytes -= _bytes;
+	}
 	// prevents loading twice
 	if (_loaded) return;
 	_loaded = true;
@@ -248,10 +260,43 @@ void MapDataSet::loadData(MCDPatch *patch)
 		throw Exception("invalid MCD file: " + fname + ", check log file for more details.");
 	}
 
-	// Load terrain sprites/surfaces/PCK files into a surfaceset
+	// Load terrain sprites/surfaces/PCK files into a surfaceset,
+	// frames are only decoded once the map draws them
 	_surfaceSet = new SurfaceSet(32, 40);
 	_surfaceSet->loadPck(FileMap::getFilePath("TERRAIN/" + _name + ".PCK"),
-			     FileMap::getFilePath("TERRAIN/" + _name + ".TAB"));
+			     FileMap::getFilePath("TERRAIN/" + _name + ".TAB"), true);
+	_bytes = _objects.size() * sizeof(MapData) + _surfaceSet->getTotalFrames() * _surfaceSet->getWidth() * _surfaceSet->getHeight();
+}
+
+/**
+ * Tells the dataset one less battle is using it. Unused data stays
+ * loaded, so the next mission on the same terrain can skip decoding
+ * it, until the idle datasets go over the terrain memory budget.
+ */
+void MapDataSet::release()
+{
+	if (_references == 0)
+		return;
+	if (--_references == 0 && _loaded)
+	{
+		_idle.push_back(this);
+		_idleBytes += _bytes;
+		trimIdle();
+	}
+}
+
+/**
+ * Unloads the datasets that have been idle the longest,
+ * until the rest fit in the terrain memory budget.
+ */
+void MapDataSet::trimIdle()
+{
+	size_t budget = (size_t)std::max(0, Options::terrainMemoryBudget) * 1024 * 1024;
+	while (_idleBytes > budget && !_idle.empty())
+	{
+		Log(LOG_VERBOSE) << "Unloading terrain: " << _idle.front()->getName();
+		_idle.front()->unloadData();
+	}
 }
 
 /**
@@ -261,12 +306,19 @@ void MapDataSet::unloadData()
 {
 	if (_loaded)
 	{
+		if (_references == 0)
+		{
+			_idle.remove(this);
+			_idleBytes -= _bytes;
+		}
+		_references = 0;
 		for (std::vector<MapData*>::iterator i = _objects.begin(); i != _objects.end(); ++i)
 		{
 			delete *i;
 		}
 		_objects.clear();
 		delete _surfaceSet;
+		_surfaceSet = 0;
 		_loaded = false;
 	}
 }
@@ -19,6 +19,7 @@
  */
 #include <string>
 #include <vector>
+#include <list>
 #include <SDL.h>
 #include <yaml-cpp/yaml.h>
 #include "../Mod/MCDPatch.h"
@@ -42,8 +43,14 @@ private:
 	std::vector<MapData*> _objects;
 	SurfaceSet *_surfaceSet;
 	bool _loaded;
+	int _references;
+	size_t _bytes;
 	static MapData *_blankTile;
 	static MapData *_scorchedTile;
+	static std::list<MapDataSet*> _idle;
+	static size_t _idleBytes;
+	/// Unloads idle datasets until they fit in the memory budget.
+	static void trimIdle();
 public:
 	MapDataSet(const std::string &name);
 	~MapDataSet();
@@ -59,6 +66,8 @@ public:
 	SurfaceSet *getSurfaceset() const;
 	/// Loads the objects from an MCD file.
 	void loadData(MCDPatch *patch);
+	/// Tells the dataset a battle doesn't use it anymore.
+	void release();
 	///	Unloads to free memory.
 	void unloadData();
 	/// Gets a blank floor tile.
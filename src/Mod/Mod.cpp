@@ -198,12 +198,40 @@ void Mod::resetGlobalStatics()
 	DIFFICULTY_COEFFICIENT[4] = 4;
 }
 
+namespace
+{
+
+/**
+ * Holds the resource lock until the end of the scope. Surfaces can be
+ * requested by the battlescape generator while it runs on another thread.
+ */
+struct ResourceLock
+{
+	SDL_mutex *_mutex;
+	ResourceLock(SDL_mutex *mutex) : _mutex(mutex)
+	{
+		SDL_mutexP(_mutex);
+	}
+	~ResourceLock()
+	{
+		SDL_mutexV(_mutex);
+	}
+};
+
+}
+
 /**
  * Creates an empty mod.
  */
 Mod::Mod() : _costEngineer(0), _costScientist(0), _timePersonnel(0), _initialFunding(0), _turnAIUseGrenade(3), _turnAIUseBlaster(3), _defeatScore(0), _defeatFunds(0), _difficultyDemigod(false), _startingTime(6, 1, 1, 1999, 12, 0, 0),
-			 _facilityListOrder(0), _craftListOrder(0), _itemListOrder(0), _researchListOrder(0),  _manufactureListOrder(0), _ufopaediaListOrder(0), _invListOrder(0), _modCurrent(0), _statePalette(0)
-{
+			 _facilityListOrder(0), _craftListOrder(0), _itemListOrder(0), _researchListOrder(0),  _manufactureListOrder(0), _ufopaediaListOrder(0), _invListOrder(0), _modCurrent(0), _statePalette(0),
+			 _residencyOwner(0), _residencyFrame(0), _residencyActive(false), _resourceLock(SDL_CreateMutex())
+{
+	_residencyStats.hits = 0;
+	_residencyStats.misses = 0;
+	_residencyStats.evictions = 0;
+	_residencyStats.bytesResident = 0;
+	_residencyStats.loadTicks = 0;
 	_muteMusic = new Music();
 	_muteSound = new Sound();
 	_globe = new RuleGlobe();
@@ -222,6 +250,7 @@ Mod::Mod() : _costEngineer(0), _costScientist(0), _timePersonnel(0), _initialFun
  */
 Mod::~Mod()
 {
+	SDL_DestroyMutex(_resourceLock);
 	delete _muteMusic;
 	delete _muteSound;
 	delete _globe;
@@ -438,14 +467,207 @@ void Mod::lazyLoadSurface(const std::string &name)
 		std::map<std::string, std::vector<ExtraSprites *> >::const_iterator i = _extraSprites.find(name);
 		if (i != _extraSprites.end())
 		{
+			if (i->second.back()->isLoaded())
+			{
+				if (_resident.find(name) != _resident.end())
+				{
+					_residencyStats.hits++;
+					touchResource(name);
+				}
+				return;
+			}
+
+			// only sprites that don't build on top of a vanilla resource
+			// (or one patched while loading) can be dropped and loaded again
+			bool droppable = _residencyActive && _surfaces.find(name) == _surfaces.end() && _sets.find(name) == _sets.end();
+			Uint32 start = SDL_GetTicks();
 			for (std::vector<ExtraSprites*>::const_iterator j = i->second.begin(); j != i->second.end(); ++j)
 			{
 				loadExtraSprite(*j);
 			}
+			if (droppable)
+			{
+				size_t bytes = 0;
+				std::map<std::string, Surface*>::const_iterator surface = _surfaces.find(name);
+				if (surface != _surfaces.end())
+				{
+					bytes += surface->second->getWidth() * surface->second->getHeight();
+				}
+				std::map<std::string, SurfaceSet*>::const_iterator set = _sets.find(name);
+				if (set != _sets.end())
+				{
+					for (std::map<int, Surface*>::const_iterator frame = set->second->getFrames()->begin(); frame != set->second->getFrames()->end(); ++frame)
+					{
+						bytes += frame->second->getWidth() * frame->second->getHeight();
+					}
+				}
+				ResidentResource &resource = _resident[name];
+				resource.bytes = bytes;
+				resource.owners.clear();
+				_residencyStats.misses++;
+				_residencyStats.bytesResident += bytes;
+				_residencyStats.loadTicks += SDL_GetTicks() - start;
+				touchResource(name);
+				resource.pending = true;
+				enforceResidencyBudget(name);
+			}
 		}
 	}
 }
 
+/**
+ * Marks a droppable resource as used by the current state
+ * in the current frame.
+ * @param name Resource name.
+ */
+void Mod::touchResource(const std::string &name)
+{
+	ResidentResource &resource = _resident[name];
+	resource.lastUse = _residencyFrame;
+	if (std::find(resource.owners.begin(), resource.owners.end(), _residencyOwner) == resource.owners.end())
+	{
+		resource.owners.push_back(_residencyOwner);
+	}
+}
+
+/**
+ * Drops the least recently used resources that no state
+ * holds anymore, until the memory used by droppable
+ * resources fits in the budget. Dropped resources are
+ * loaded again the next time they're requested.
+ * @param keep Resource that must not be dropped.
+ */
+void Mod::enforceResidencyBudget(const std::string &keep)
+{
+	size_t budget = (size_t)Options::resourceMemoryBudget * 1024 * 1024;
+	if (budget == 0)
+	{
+		return;
+	}
+	while (_residencyStats.bytesResident > budget)
+	{
+		std::map<std::string, ResidentResource>::iterator oldest = _resident.end();
+		for (std::map<std::string, ResidentResource>::iterator i = _resident.begin(); i != _resident.end(); ++i)
+		{
+			const ResidentResource &resource = i->second;
+			if (i->first == keep || resource.pending || !resource.owners.empty() || resource.lastUse == _residencyFrame)
+				continue;
+			if (oldest == _resident.end() || resource.lastUse < oldest->second.lastUse)
+			{
+				oldest = i;
+			}
+		}
+		if (oldest == _resident.end())
+		{
+			break;
+		}
+
+		const std::string &name = oldest->first;
+		Log(LOG_VERBOSE) << "Dropping resource: " << name;
+		std::map<std::string, Surface*>::iterator surface = _surfaces.find(name);
+		if (surface != _surfaces.end())
+		{
+			delete surface->second;
+			_surfaces.erase(surface);
+		}
+		std::map<std::string, SurfaceSet*>::iterator set = _sets.find(name);
+		if (set != _sets.end())
+		{
+			delete set->second;
+			_sets.erase(set);
+		}
+		std::vector<ExtraSprites*> &packs = _extraSprites[name];
+		for (std::vector<ExtraSprites*>::iterator i = packs.begin(); i != packs.end(); ++i)
+		{
+			(*i)->unload();
+		}
+		_residencyStats.evictions++;
+		_residencyStats.bytesResident -= oldest->second.bytes;
+		_resident.erase(oldest);
+	}
+}
+
+/**
+ * Called when a state is pushed, so it keeps the resources
+ * loaded while it was being created (states request most
+ * of their resources in their constructor, right before
+ * they're pushed).
+ * @param state Pointer to the new state.
+ */
+void Mod::pushResidencyOwner(const State *state)
+{
+	ResourceLock lock(_resourceLock);
+	if (!_residencyActive)
+		return;
+	for (std::map<std::string, ResidentResource>::iterator i = _resident.begin(); i != _resident.end(); ++i)
+	{
+		if (i->second.pending)
+		{
+			i->second.pending = false;
+			if (std::find(i->second.owners.begin(), i->second.owners.end(), state) == i->second.owners.end())
+			{
+				i->second.owners.push_back(state);
+			}
+		}
+	}
+	_residencyOwner = state;
+}
+
+/**
+ * Sets the state that owns the resources requested from now on.
+ * @param state Pointer to the active state.
+ */
+void Mod::setResidencyOwner(const State *state)
+{
+	ResourceLock lock(_resourceLock);
+	_residencyOwner = state;
+}
+
+/**
+ * Called when a state is deleted, so the resources it
+ * requested can be dropped if no other state holds them.
+ * @param state Pointer to the deleted state.
+ */
+void Mod::releaseResources(const State *state)
+{
+	ResourceLock lock(_resourceLock);
+	if (!_residencyActive)
+		return;
+	for (std::map<std::string, ResidentResource>::iterator i = _resident.begin(); i != _resident.end(); ++i)
+	{
+		std::vector<const State*>::iterator owner = std::find(i->second.owners.begin(), i->second.owners.end(), state);
+		if (owner != i->second.owners.end())
+		{
+			i->second.owners.erase(owner);
+		}
+	}
+}
+
+/**
+ * Starts a new frame. Resources requested in the current
+ * frame are never dropped, since they may still be in use.
+ * Resources loaded in the last frame without a state being
+ * pushed belong to the states that requested them.
+ */
+void Mod::updateResidency()
+{
+	ResourceLock lock(_resourceLock);
+	_residencyFrame++;
+	for (std::map<std::string, ResidentResource>::iterator i = _resident.begin(); i != _resident.end(); ++i)
+	{
+		i->second.pending = false;
+	}
+}
+
+/**
+ * Gets the counters for the resources that can be dropped.
+ * @return Residency counters.
+ */
+const ResidencyStats &Mod::getResidencyStats() const
+{
+	return _residencyStats;
+}
+
 /**
  * Returns a specific surface from the mod.
  * @param name Name of the surface.
@@ -453,6 +675,7 @@ void Mod::lazyLoadSurface(const std::string &name)
  */
 Surface *Mod::getSurface(const std::string &name, bool error)
 {
+	ResourceLock lock(_resourceLock);
 	lazyLoadSurface(name);
 	return getRule(name, "Sprite", _surfaces, error);
 }
@@ -464,6 +687,7 @@ Surface *Mod::getSurface(const std::string &name, bool error)
  */
 SurfaceSet *Mod::getSurfaceSet(const std::string &name, bool error)
 {
+	ResourceLock lock(_resourceLock);
 	lazyLoadSurface(name);
 	return getRule(name, "Sprite Set", _sets, error);
 }
@@ -950,8 +1174,16 @@ void Mod::loadAll(const std::vector< std::pair< std::string, std::vector<std::st
 	//back master
 	_modCurrent = &_modData.at(0);
 	sortLists();
+	indexRules();
+	linkResearch();
+	_globe->indexPolygons();
 	loadExtraResources();
 	modResources();
+	if (!Options::lazyLoadResources)
+	{
+		preloadMapBlocks();
+	}
+	_residencyActive = Options::lazyLoadResources;
 }
 
 /**
@@ -2493,6 +2725,37 @@ void Mod::sortLists()
 	std::sort(_ufopaediaCatIndex.begin(), _ufopaediaCatIndex.end(), compareSection(this));
 }
 
+/**
+ * Assigns every research rule a dense handle matching its
+ * position in the sorted list, so the savegame can keep
+ * research state in flat arrays instead of looking it up
+ * by name.
+ */
+void Mod::indexRules()
+{
+	for (size_t i = 0; i < _researchIndex.size(); ++i)
+	{
+		getResearch(_researchIndex[i], true)->setIndex(i);
+	}
+}
+
+/**
+ * Resolves the research names referenced by research and
+ * manufacture rules, and records which manufacture projects
+ * depend on each research.
+ */
+void Mod::linkResearch()
+{
+	for (std::vector<std::string>::const_iterator i = _researchIndex.begin(); i != _researchIndex.end(); ++i)
+	{
+		getResearch(*i, true)->afterLoad(this);
+	}
+	for (std::vector<std::string>::const_iterator i = _manufactureIndex.begin(); i != _manufactureIndex.end(); ++i)
+	{
+		getManufacture(*i, true)->afterLoad(this);
+	}
+}
+
 /**
  * Gets the research-requirements for Psi-Lab (it's a cache for psiStrengthEval)
  */
@@ -3482,6 +3745,38 @@ void Mod::loadExtraSprite(ExtraSprites *spritePack)
 	}
 }
 
+/**
+ * Reads the MAP and RMP files of every terrain, ufo and craft
+ * map block while we're still on the loading screen, so
+ * generating a battlescape doesn't have to touch the disk.
+ */
+void Mod::preloadMapBlocks()
+{
+	Log(LOG_INFO) << "Loading map blocks...";
+	std::vector<RuleTerrain*> terrains;
+	for (std::map<std::string, RuleTerrain*>::const_iterator i = _terrains.begin(); i != _terrains.end(); ++i)
+	{
+		terrains.push_back(i->second);
+	}
+	for (std::map<std::string, RuleUfo*>::const_iterator i = _ufos.begin(); i != _ufos.end(); ++i)
+	{
+		terrains.push_back(i->second->getBattlescapeTerrainData());
+	}
+	for (std::map<std::string, RuleCraft*>::const_iterator i = _crafts.begin(); i != _crafts.end(); ++i)
+	{
+		terrains.push_back(i->second->getBattlescapeTerrainData());
+	}
+	for (std::vector<RuleTerrain*>::const_iterator i = terrains.begin(); i != terrains.end(); ++i)
+	{
+		if (*i == 0)
+			continue;
+		for (std::vector<MapBlock*>::const_iterator j = (*i)->getMapBlocks()->begin(); j != (*i)->getMapBlocks()->end(); ++j)
+		{
+			(*j)->preload();
+		}
+	}
+}
+
 /**
  * Applies necessary modifications to vanilla resources.
  */
@@ -79,6 +79,7 @@ class ModInfo;
 class RuleVideo;
 class RuleMusic;
 class RuleMissionScript;
+class State;
 struct StatAdjustment;
 
 /**
@@ -96,6 +97,41 @@ struct ModData
 	size_t size;
 };
 
+/**
+ * Residency counters for lazy loaded resources.
+ */
+struct ResidencyStats
+{
+	/// Requests for resources that were already loaded.
+	size_t hits;
+	/// Requests that had to load (or reload) a resource.
+	size_t misses;
+	/// Resources dropped to stay within the memory budget.
+	size_t evictions;
+	/// Memory used by the resources that can be dropped.
+	size_t bytesResident;
+	/// Time spent loading those resources, in milliseconds.
+	Uint32 loadTicks;
+};
+
+/**
+ * A lazy loaded resource that can be dropped and loaded again.
+ * Only sprites are tracked: sound sets hand out sounds that widgets
+ * and mixer channels keep using, and music tracks are streamed from
+ * their files, so neither can or needs to be dropped.
+ */
+struct ResidentResource
+{
+	/// Approximate memory used by the resource.
+	size_t bytes;
+	/// Frame the resource was last requested in.
+	Uint32 lastUse;
+	/// Loaded in this frame before the next state was pushed.
+	bool pending;
+	/// States that requested the resource and may still use it.
+	std::vector<const State*> owners;
+};
+
 /**
  * Contains all the game-specific static data that never changes
  * throughout the game, like rulesets and resources.
@@ -169,6 +205,12 @@ private:
 	ModData* _modCurrent;
 	SDL_Color *_statePalette;
 	std::vector<std::string> _psiRequirements; // it's a cache for psiStrengthEval
+	std::map<std::string, ResidentResource> _resident;
+	const State *_residencyOwner;
+	Uint32 _residencyFrame;
+	bool _residencyActive;
+	ResidencyStats _residencyStats;
+	SDL_mutex *_resourceLock;
 
 	/// Loads a ruleset from a YAML file that have basic resources configuration.
 	void loadResourceConfigFile(const std::string &filename);
@@ -201,10 +243,20 @@ private:
 	void lazyLoadSurface(const std::string &name);
 	/// Loads an external sprite.
 	void loadExtraSprite(ExtraSprites *spritePack);
+	/// Records a request for a resource that can be dropped.
+	void touchResource(const std::string &name);
+	/// Drops old resources until the memory budget is met.
+	void enforceResidencyBudget(const std::string &keep);
 	/// Applies mods to vanilla resources.
 	void modResources();
+	/// Reads the MAP and RMP files of every terrain ahead of time.
+	void preloadMapBlocks();
 	/// Sorts all our lists according to their weight.
 	void sortLists();
+	/// Assigns dense handles to the research rules.
+	void indexRules();
+	/// Links research and manufacture rules into a dependency graph.
+	void linkResearch();
 public:
 	static int DOOR_OPEN;
 	static int SLIDING_DOOR_OPEN;
@@ -270,6 +322,16 @@ public:
 	Sound *getSoundByDepth(unsigned int depth, unsigned int sound, bool error = true) const;
 	/// Gets list of LUT data.
 	const std::vector<std::vector<Uint8> > *getLUTs() const;
+	/// Attaches the recently requested resources to a new state.
+	void pushResidencyOwner(const State *state);
+	/// Sets the state requesting resources.
+	void setResidencyOwner(const State *state);
+	/// Releases the resources held by a state.
+	void releaseResources(const State *state);
+	/// Starts a new frame for resource residency.
+	void updateResidency();
+	/// Gets the resource residency counters.
+	const ResidencyStats &getResidencyStats() const;
 
 	/// Gets the mod offset.
 	int getModOffset() const;
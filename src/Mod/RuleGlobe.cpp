@@ -18,6 +18,7 @@
  */
 #include "RuleGlobe.h"
 #include <SDL_endian.h>
+#include <algorithm>
 #include <fstream>
 #include "../Engine/Exception.h"
 #include "Polygon.h"
@@ -31,6 +32,73 @@
 namespace OpenXcom
 {
 
+namespace
+{
+
+/// Height of the polygon index cells, in radians.
+const double INDEX_CELL = M_PI / 180.0;
+/// Number of latitude bands in the polygon index.
+const int INDEX_BANDS = 180;
+
+/**
+ * Checks if a point is inside a world polygon, by projecting
+ * the polygon around the point.
+ * @param poly Pointer to the polygon.
+ * @param lon Longitude of the point.
+ * @param coslat Cosine of the latitude of the point.
+ * @param sinlat Sine of the latitude of the point.
+ * @return True if the point is inside.
+ */
+bool insidePolygon(const Polygon *poly, double lon, double coslat, double sinlat)
+{
+	const double zDiscard=0.75f;
+	double x, y, z, x2, y2;
+	double clat, clon;
+	z = 0;
+	for (int j = 0; j < poly->getPoints(); ++j)
+	{
+		z = coslat * cos(poly->getLatitude(j)) * cos(poly->getLongitude(j) - lon) + sinlat * sin(poly->getLatitude(j));
+		if (z<zDiscard) return false; //discarded
+	}
+
+	bool odd = false;
+
+	clat = poly->getLatitude(0); //initial point
+	clon = poly->getLongitude(0);
+	x = cos(clat) * sin(clon - lon);
+	y = coslat * sin(clat) - sinlat * cos(clat) * cos(clon - lon);
+
+	for (int j = 0; j < poly->getPoints(); ++j)
+	{
+		int k = (j + 1) % poly->getPoints(); //index of next point in poly
+		clat = poly->getLatitude(k);
+		clon = poly->getLongitude(k);
+
+		x2 = cos(clat) * sin(clon - lon);
+		y2 = coslat * sin(clat) - sinlat * cos(clat) * cos(clon - lon);
+		if ( ((y>0)!=(y2>0)) && (0 < (x2-x)*(0-y)/(y2-y)+x) )
+			odd = !odd;
+		x = x2;
+		y = y2;
+	}
+	return odd;
+}
+
+/**
+ * Wraps an angle difference to the [-pi, pi) range.
+ * @param angle Angle in radians.
+ * @return Wrapped angle.
+ */
+double wrapAngle(double angle)
+{
+	angle = fmod(angle + M_PI, 2 * M_PI);
+	if (angle < 0)
+		angle += 2 * M_PI;
+	return angle - M_PI;
+}
+
+}
+
 /**
  * Creates a blank ruleset for globe contents.
  */
@@ -228,6 +296,148 @@ Texture *RuleGlobe::getTexture(int id) const
 	if (_textures.end() != i) return i->second; else return 0;
 }
 
+/**
+ * Gets the number of cells in a band of the polygon index.
+ * Bands closer to the poles have less cells, so they're
+ * all roughly the same area.
+ * @param band Band number, from the south pole.
+ * @return Number of cells.
+ */
+int RuleGlobe::getBandCells(int band)
+{
+	double lat = -M_PI_2 + (band + 0.5) * INDEX_CELL;
+	return std::max(1, (int)ceil(2 * M_PI * cos(lat) / INDEX_CELL));
+}
+
+/**
+ * Builds an index of the world polygons, splitting the globe
+ * in cells of roughly one degree, each listing the polygons
+ * that might cover it. Must be called after loading
+ * the polygons.
+ */
+void RuleGlobe::indexPolygons()
+{
+	_bandStart.resize(INDEX_BANDS + 1);
+	int cells = 0;
+	for (int band = 0; band < INDEX_BANDS; ++band)
+	{
+		_bandStart[band] = cells;
+		cells += getBandCells(band);
+	}
+	_bandStart[INDEX_BANDS] = cells;
+
+	std::vector< std::vector<Polygon*> > candidates(cells);
+	for (std::list<Polygon*>::iterator i = _polygons.begin(); i != _polygons.end(); ++i)
+	{
+		Polygon *poly = *i;
+		if (poly->getPoints() == 0)
+			continue;
+
+		// find the bounds of the polygon, unwrapping the longitudes around the first point
+		double latMin = poly->getLatitude(0), latMax = latMin;
+		double lonMin = poly->getLongitude(0), lonMax = lonMin;
+		double lon = lonMin, winding = 0;
+		for (int j = 1; j <= poly->getPoints(); ++j)
+		{
+			int k = j % poly->getPoints();
+			double delta = wrapAngle(poly->getLongitude(k) - lon);
+			lon += delta;
+			winding += delta;
+			latMin = std::min(latMin, poly->getLatitude(k));
+			latMax = std::max(latMax, poly->getLatitude(k));
+			lonMin = std::min(lonMin, lon);
+			lonMax = std::max(lonMax, lon);
+		}
+
+		// the point check isn't exact along the edges, so leave a generous margin
+		double margin = INDEX_CELL + 0.25 * (latMax - latMin) + 0.25 * (lonMax - lonMin);
+		latMin -= margin;
+		latMax += margin;
+		bool fullCircle = fabs(winding) > M_PI || latMax >= M_PI_2 - INDEX_CELL || latMin <= -M_PI_2 + INDEX_CELL;
+		if (fabs(winding) > M_PI)
+		{
+			// polygon around a pole
+			if (latMax + latMin > 0)
+				latMax = M_PI_2;
+			else
+				latMin = -M_PI_2;
+		}
+		if (!fullCircle)
+		{
+			double lonMargin = margin / cos(std::max(fabs(latMin), fabs(latMax)));
+			lonMin -= lonMargin;
+			lonMax += lonMargin;
+			fullCircle = lonMax - lonMin >= 2 * M_PI;
+		}
+
+		int bandMin = std::max(0, (int)floor((latMin + M_PI_2) / INDEX_CELL));
+		int bandMax = std::min(INDEX_BANDS - 1, (int)floor((latMax + M_PI_2) / INDEX_CELL));
+		for (int band = bandMin; band <= bandMax; ++band)
+		{
+			int bandCells = _bandStart[band + 1] - _bandStart[band];
+			int cellMin = 0, cellMax = bandCells - 1;
+			if (!fullCircle)
+			{
+				cellMin = (int)floor(lonMin / (2 * M_PI) * bandCells);
+				cellMax = std::min(cellMin + bandCells - 1, (int)floor(lonMax / (2 * M_PI) * bandCells));
+			}
+			for (int cell = cellMin; cell <= cellMax; ++cell)
+			{
+				int wrapped = ((cell % bandCells) + bandCells) % bandCells;
+				candidates[_bandStart[band] + wrapped].push_back(poly);
+			}
+		}
+	}
+
+	_cellStart.resize(cells + 1);
+	_cellPolygons.clear();
+	for (int band = 0; band < INDEX_BANDS; ++band)
+	{
+		int bandCells = _bandStart[band + 1] - _bandStart[band];
+		for (int cell = 0; cell < bandCells; ++cell)
+		{
+			const std::vector<Polygon*> &list = candidates[_bandStart[band] + cell];
+			_cellStart[_bandStart[band] + cell] = _cellPolygons.size();
+			_cellPolygons.insert(_cellPolygons.end(), list.begin(), list.end());
+		}
+	}
+	_cellStart[cells] = _cellPolygons.size();
+}
+
+/**
+ * Gets the world polygon that contains a point.
+ * @param lon Longitude of the point.
+ * @param lat Latitude of the point.
+ * @return Pointer to the polygon, or NULL if it's on water.
+ */
+Polygon *RuleGlobe::getPolygonFromLonLat(double lon, double lat) const
+{
+	double coslat = cos(lat);
+	double sinlat = sin(lat);
+	if (_cellStart.empty())
+	{
+		for (std::list<Polygon*>::const_iterator i = _polygons.begin(); i != _polygons.end(); ++i)
+		{
+			if (insidePolygon(*i, lon, coslat, sinlat))
+				return *i;
+		}
+		return 0;
+	}
+
+	int band = std::min(INDEX_BANDS - 1, std::max(0, (int)floor((lat + M_PI_2) / INDEX_CELL)));
+	int bandCells = _bandStart[band + 1] - _bandStart[band];
+	double wrapped = fmod(lon, 2 * M_PI);
+	if (wrapped < 0)
+		wrapped += 2 * M_PI;
+	int cell = _bandStart[band] + std::min(bandCells - 1, (int)(wrapped / (2 * M_PI) * bandCells));
+	for (int i = _cellStart[cell]; i < _cellStart[cell + 1]; ++i)
+	{
+		if (insidePolygon(_cellPolygons[i], lon, coslat, sinlat))
+			return _cellPolygons[i];
+	}
+	return 0;
+}
+
 /**
  * Returns a list of all globe terrains associated with this deployment.
  * @param deployment Deployment name.
@@ -19,6 +19,7 @@
  */
 #include <list>
 #include <string>
+#include <vector>
 #include <yaml-cpp/yaml.h>
 
 namespace OpenXcom
@@ -39,6 +40,10 @@ private:
 	std::list<Polygon*> _polygons;
 	std::list<Polyline*> _polylines;
 	std::map<int, Texture*> _textures;
+	std::vector<int> _bandStart, _cellStart;
+	std::vector<Polygon*> _cellPolygons;
+	/// Gets the number of index cells in a latitude band.
+	static int getBandCells(int band);
 public:
 	/// Creates a blank globe ruleset.
 	RuleGlobe();
@@ -56,6 +61,10 @@ public:
 	Texture *getTexture(int id) const;
 	/// Gets all the terrains for a specific deployment.
 	std::vector<std::string> getTerrains(const std::string &deployment) const;
+	/// Builds the lookup index for the world polygons.
+	void indexPolygons();
+	/// Gets the world polygon at a point.
+	Polygon *getPolygonFromLonLat(double lon, double lat) const;
 };
 
 }
@@ -17,6 +17,8 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "RuleManufacture.h"
+#include "RuleResearch.h"
+#include "Mod.h"
 
 namespace OpenXcom
 {
@@ -152,4 +154,34 @@ int RuleManufacture::getListOrder() const
 	return _listOrder;
 }
 
+/**
+ * Resolves the research requirements into rules once all the
+ * rulesets are loaded, and registers this project with each of
+ * them so completing a research only has to look at its own
+ * dependent projects.
+ * @param mod Pointer to the mod.
+ */
+void RuleManufacture::afterLoad(Mod *mod)
+{
+	_requiresRules.clear();
+	for (std::vector<std::string>::const_iterator i = _requires.begin(); i != _requires.end(); ++i)
+	{
+		RuleResearch *research = mod->getResearch(*i);
+		if (research)
+		{
+			research->addDependentManufacture(this);
+		}
+		_requiresRules.push_back(research);
+	}
+}
+
+/**
+ * Gets the list of research required to manufacture this object, as rules.
+ * @return A list of research rules.
+ */
+const std::vector<const RuleResearch*> &RuleManufacture::getRequirementRules() const
+{
+	return _requiresRules;
+}
+
 }
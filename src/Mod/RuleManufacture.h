@@ -19,12 +19,16 @@
  */
 #include <string>
 #include <map>
+#include <vector>
 #include <yaml-cpp/yaml.h>
 #include <stdint.h>
 
 namespace OpenXcom
 {
 
+class Mod;
+class RuleResearch;
+
 /**
  * Represents the information needed to manufacture an object.
  */
@@ -36,6 +40,7 @@ private:
 	int _space, _time, _cost;
 	std::map<std::string, int> _requiredItems, _producedItems;
 	int _listOrder;
+	std::vector<const RuleResearch*> _requiresRules;
 public:
 	/// Creates a new manufacture.
 	RuleManufacture(const std::string &name);
@@ -62,6 +67,10 @@ public:
 	const std::map<std::string, int> & getProducedItems() const;
 	/// Gets the list weight for this manufacture item.
 	int getListOrder() const;
+	/// Cross-links the manufacture with the other loaded rules.
+	void afterLoad(Mod *mod);
+	/// Gets the manufacture's requirements as rules.
+	const std::vector<const RuleResearch*> &getRequirementRules() const;
 };
 
 }
@@ -17,12 +17,14 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "RuleResearch.h"
+#include <algorithm>
 #include "../Engine/Exception.h"
+#include "Mod.h"
 
 namespace OpenXcom
 {
 
-RuleResearch::RuleResearch(const std::string & name) : _name(name), _cost(0), _points(0), _needItem(false), _destroyItem(false), _listOrder(0)
+RuleResearch::RuleResearch(const std::string & name) : _name(name), _cost(0), _points(0), _needItem(false), _destroyItem(false), _listOrder(0), _index(-1)
 {
 }
 
@@ -163,4 +165,115 @@ const std::string & RuleResearch::getCutscene() const
 	return _cutscene;
 }
 
+/**
+ * Gets the dense handle assigned to this research
+ * after all the rulesets are loaded.
+ * @return The research handle.
+ */
+int RuleResearch::getIndex() const
+{
+	return _index;
+}
+
+/**
+ * Sets the dense handle for this research.
+ * @param index The research handle.
+ */
+void RuleResearch::setIndex(int index)
+{
+	_index = index;
+}
+
+
+/**
+ * Resolves a list of research names into rules.
+ * Unknown names are kept as null entries, so a
+ * list referring to them can never be completed.
+ * @param mod Pointer to the mod.
+ * @param names List of research names.
+ * @param rules List of research rules to fill.
+ */
+static void resolveResearch(const Mod *mod, const std::vector<std::string> &names, std::vector<const RuleResearch*> &rules)
+{
+	rules.clear();
+	for (std::vector<std::string>::const_iterator i = names.begin(); i != names.end(); ++i)
+	{
+		rules.push_back(mod->getResearch(*i));
+	}
+}
+
+/**
+ * Cross-links the research with the other rules once
+ * all the rulesets are loaded, so the research tree can
+ * be walked without looking topics up by name.
+ * @param mod Pointer to the mod.
+ */
+void RuleResearch::afterLoad(const Mod *mod)
+{
+	resolveResearch(mod, _dependencies, _dependencyRules);
+	resolveResearch(mod, _unlocks, _unlockRules);
+	resolveResearch(mod, _getOneFree, _getOneFreeRules);
+	resolveResearch(mod, _requires, _requiresRules);
+	_dependentManufacture.clear();
+}
+
+/**
+ * Gets the list of dependencies as research rules.
+ * @return The list of research rules.
+ */
+const std::vector<const RuleResearch*> & RuleResearch::getDependencyRules() const
+{
+	return _dependencyRules;
+}
+
+/**
+ * Gets the list of ResearchProjects unlocked by this research as rules.
+ * @return The list of research rules.
+ */
+const std::vector<const RuleResearch*> & RuleResearch::getUnlockRules() const
+{
+	return _unlockRules;
+}
+
+/**
+ * Gets the list of ResearchProjects granted at random for free by this research as rules.
+ * @return The list of research rules.
+ */
+const std::vector<const RuleResearch*> & RuleResearch::getGetOneFreeRules() const
+{
+	return _getOneFreeRules;
+}
+
+/**
+ * Gets the requirements for this ResearchProject as rules.
+ * @return The list of research rules.
+ */
+const std::vector<const RuleResearch*> & RuleResearch::getRequirementRules() const
+{
+	return _requiresRules;
+}
+
+/**
+ * Registers a manufacture project that lists this research
+ * among its requirements.
+ * @param manufacture The manufacture project.
+ */
+void RuleResearch::addDependentManufacture(RuleManufacture *manufacture)
+{
+	if (std::find(_dependentManufacture.begin(), _dependentManufacture.end(), manufacture) == _dependentManufacture.end())
+	{
+		_dependentManufacture.push_back(manufacture);
+	}
+}
+
+/**
+ * Gets the manufacture projects that list this research
+ * among their requirements.
+ * @return The list of manufacture projects.
+ */
+const std::vector<RuleManufacture*> & RuleResearch::getDependentManufacture() const
+{
+	return _dependentManufacture;
+}
+
 }
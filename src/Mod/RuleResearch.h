@@ -23,6 +23,10 @@
 
 namespace OpenXcom
 {
+
+class Mod;
+class RuleManufacture;
+
 /**
  * Represents one research project.
  * Dependency is the list of RuleResearchs which must be discovered before a RuleResearch became available.
@@ -42,7 +46,9 @@ class RuleResearch
 	int _cost, _points;
 	std::vector<std::string> _dependencies, _unlocks, _getOneFree, _requires;
 	bool _needItem, _destroyItem;
-	int _listOrder;
+	int _listOrder, _index;
+	std::vector<const RuleResearch*> _dependencyRules, _unlockRules, _getOneFreeRules, _requiresRules;
+	std::vector<RuleManufacture*> _dependentManufacture;
 public:
 	RuleResearch(const std::string & name);
 	/// Loads the research from YAML.
@@ -71,6 +77,24 @@ public:
 	int getListOrder() const;
 	/// Gets the cutscene to play when this item is researched
 	const std::string & getCutscene() const;
+	/// Gets the handle for this research.
+	int getIndex() const;
+	/// Sets the handle for this research.
+	void setIndex(int index);
+	/// Cross-links the research with the other loaded rules.
+	void afterLoad(const Mod *mod);
+	/// Gets the research dependencies as rules.
+	const std::vector<const RuleResearch*> & getDependencyRules() const;
+	/// Gets the ResearchProjects unlocked by this research as rules.
+	const std::vector<const RuleResearch*> & getUnlockRules() const;
+	/// Gets the ResearchProjects granted for free by this research as rules.
+	const std::vector<const RuleResearch*> & getGetOneFreeRules() const;
+	/// Gets the research requirements as rules.
+	const std::vector<const RuleResearch*> & getRequirementRules() const;
+	/// Adds a manufacture project requiring this research.
+	void addDependentManufacture(RuleManufacture *manufacture);
+	/// Gets the manufacture projects requiring this research.
+	const std::vector<RuleManufacture*> & getDependentManufacture() const;
 };
 
 /**
@@ -21,6 +21,8 @@
 #include <stack>
 #include <algorithm>
 #include <functional>
+#include <cassert>
+#include <cstring>
 #include "BaseFacility.h"
 #include "../Mod/RuleBaseFacility.h"
 #include "Craft.h"
@@ -53,7 +55,7 @@ namespace OpenXcom
  * Initializes an empty base.
  * @param mod Pointer to mod.
  */
-Base::Base(const Mod *mod) : Target(), _mod(mod), _scientists(0), _engineers(0), _inBattlescape(false), _retaliationTarget(false)
+Base::Base(const Mod *mod) : Target(), _mod(mod), _scientists(0), _engineers(0), _inBattlescape(false), _retaliationTarget(false), _radarRange(0), _radarFacilities(false), _radarsValid(false), _capacityValid(false)
 {
 	_items = new ItemContainer();
 }
@@ -125,6 +127,7 @@ void Base::load(const YAML::Node &node, SavedGame *save, bool newGame, bool newB
 			}
 		}
 	}
+	invalidateFacilities();
 
 	for (YAML::const_iterator i = node["crafts"].begin(); i != node["crafts"].end(); ++i)
 	{
@@ -441,6 +444,103 @@ void Base::setEngineers(int engineers)
 	 _engineers = engineers;
 }
 
+/**
+ * Adds up the space, defense, detection and maintenance
+ * provided by all the finished facilities in the base.
+ * @return Facility totals.
+ */
+BaseCapacity Base::calculateCapacity() const
+{
+	BaseCapacity total = {};
+	int minRadarRange = _mod->getMinRadarRange();
+	for (std::vector<BaseFacility*>::const_iterator i = _facilities.begin(); i != _facilities.end(); ++i)
+	{
+		if ((*i)->getBuildTime() != 0)
+			continue;
+		const RuleBaseFacility *rules = (*i)->getRules();
+		total.quarters += rules->getPersonnel();
+		total.stores += rules->getStorage();
+		total.laboratories += rules->getLaboratories();
+		total.workshops += rules->getWorkshops();
+		total.hangars += rules->getCrafts();
+		total.psiLabs += rules->getPsiLaboratories();
+		total.containment += rules->getAliens();
+		total.defense += rules->getDefenseValue();
+		total.maintenance += rules->getMonthlyCost();
+		if (minRadarRange != 0 && rules->getRadarRange() == minRadarRange)
+			total.shortRangeDetection++;
+		if (rules->getRadarRange() > minRadarRange)
+			total.longRangeDetection++;
+	}
+	return total;
+}
+
+/**
+ * Returns the facility totals, adding them up again
+ * only if the facilities changed since the last time.
+ * Debug builds check they're still right every time.
+ * @return Facility totals.
+ */
+const BaseCapacity &Base::getCapacity() const
+{
+	if (!_capacityValid)
+	{
+		_capacity = calculateCapacity();
+		_capacityValid = true;
+	}
+#ifndef NDEBUG
+	else
+	{
+		BaseCapacity check = calculateCapacity();
+		assert(memcmp(&check, &_capacity, sizeof(BaseCapacity)) == 0 && "Base facilities changed without invalidateFacilities()");
+	}
+#endif
+	return _capacity;
+}
+
+/**
+ * Marks the facilities as changed, so the totals they provide
+ * get added up again. Must be called whenever a facility is
+ * added, removed or finished.
+ */
+void Base::invalidateFacilities()
+{
+	_capacityValid = false;
+	_radarsValid = false;
+}
+
+/**
+ * Collects the finished facilities that can detect targets,
+ * in order, and their longest range, so detection checks
+ * don't have to go through every facility. Only done
+ * again once the facilities change.
+ */
+void Base::updateRadars() const
+{
+	if (_radarsValid)
+		return;
+	_radarsValid = true;
+	_radars.clear();
+	_radarRange = 0;
+	_radarFacilities = false;
+	for (std::vector<BaseFacility*>::const_iterator i = _facilities.begin(); i != _facilities.end(); ++i)
+	{
+		if ((*i)->getBuildTime() != 0)
+			continue;
+		const RuleBaseFacility *rules = (*i)->getRules();
+		if (rules->getRadarRange() > 0 || rules->getRadarChance() != 0 || rules->isHyperwave())
+		{
+			_radars.push_back(rules);
+			_radarRange = std::max(_radarRange, (double)rules->getRadarRange());
+		}
+		else
+		{
+			// any facility has a range of zero
+			_radarFacilities = true;
+		}
+	}
+}
+
 /**
  * Returns if a certain target is covered by the base's
  * radar range, taking in account the range and chance.
@@ -449,14 +549,19 @@ void Base::setEngineers(int engineers)
  */
 int Base::detect(Target *target) const
 {
+	updateRadars();
 	int chance = 0;
 	double distance = getDistance(target) * 60.0 * (180.0 / M_PI);
-	for (std::vector<BaseFacility*>::const_iterator i = _facilities.begin(); i != _facilities.end(); ++i)
+	if (distance > _radarRange)
 	{
-		if ((*i)->getRules()->getRadarRange() >= distance && (*i)->getBuildTime() == 0)
+		return 0;
+	}
+	for (std::vector<const RuleBaseFacility*>::const_iterator i = _radars.begin(); i != _radars.end(); ++i)
+	{
+		if ((*i)->getRadarRange() >= distance)
 		{
-			int radarChance = (*i)->getRules()->getRadarChance();
-			if ((*i)->getRules()->isHyperwave())
+			int radarChance = (*i)->getRadarChance();
+			if ((*i)->isHyperwave())
 			{
 				if (radarChance == 100 || RNG::percent(radarChance))
 				{
@@ -488,19 +593,28 @@ int Base::detect(Target *target) const
  */
 int Base::insideRadarRange(Target *target) const
 {
+	updateRadars();
 	bool insideRange = false;
 	double distance = getDistance(target) * 60.0 * (180.0 / M_PI);
-	for (std::vector<BaseFacility*>::const_iterator i = _facilities.begin(); i != _facilities.end(); ++i)
+	if (distance > _radarRange && (distance > 0 || !_radarFacilities))
+	{
+		return 0;
+	}
+	for (std::vector<const RuleBaseFacility*>::const_iterator i = _radars.begin(); i != _radars.end(); ++i)
 	{
-		if ((*i)->getRules()->getRadarRange() >= distance && (*i)->getBuildTime() == 0)
+		if ((*i)->getRadarRange() >= distance)
 		{
-			if ((*i)->getRules()->isHyperwave())
+			if ((*i)->isHyperwave())
 			{
 				return 2;
 			}
 			insideRange = true;
 		}
 	}
+	if (distance <= 0 && _radarFacilities)
+	{
+		insideRange = true;
+	}
 
 	return insideRange? 1 : 0;
 }
@@ -631,15 +745,7 @@ int Base::getUsedQuarters() const
  */
 int Base::getAvailableQuarters() const
 {
-	int total = 0;
-	for (std::vector<BaseFacility*>::const_iterator i = _facilities.begin(); i != _facilities.end(); ++i)
-	{
-		if ((*i)->getBuildTime() == 0)
-		{
-			total += (*i)->getRules()->getPersonnel();
-		}
-	}
-	return total;
+	return getCapacity().quarters;
 }
 
 /**
@@ -662,7 +768,7 @@ double Base::getUsedStores()
 	{
 		if ((*i)->getType() == TRANSFER_ITEM)
 		{
-			total += (*i)->getQuantity() * _mod->getItem((*i)->getItems(), true)->getSize();
+			total += (*i)->getQuantity() * (*i)->getItemRules()->getSize();
 		}
 		else if ((*i)->getType() == TRANSFER_CRAFT)
 		{
@@ -697,15 +803,7 @@ bool Base::storesOverfull(double offset)
  */
 int Base::getAvailableStores() const
 {
-	int total = 0;
-	for (std::vector<BaseFacility*>::const_iterator i = _facilities.begin(); i != _facilities.end(); ++i)
-	{
-		if ((*i)->getBuildTime() == 0)
-		{
-			total += (*i)->getRules()->getStorage();
-		}
-	}
-	return total;
+	return getCapacity().stores;
 }
 
 /**
@@ -767,15 +865,7 @@ int Base::getUsedLaboratories() const
  */
 int Base::getAvailableLaboratories() const
 {
-	int total = 0;
-	for (std::vector<BaseFacility*>::const_iterator i = _facilities.begin(); i != _facilities.end(); ++i)
-	{
-		if ((*i)->getBuildTime() == 0)
-		{
-			total += (*i)->getRules()->getLaboratories();
-		}
-	}
-	return total;
+	return getCapacity().laboratories;
 }
 
 /**
@@ -800,15 +890,7 @@ int Base::getUsedWorkshops() const
  */
 int Base::getAvailableWorkshops() const
 {
-	int total = 0;
-	for (std::vector<BaseFacility*>::const_iterator i = _facilities.begin(); i != _facilities.end(); ++i)
-	{
-		if ((*i)->getBuildTime() == 0)
-		{
-			total += (*i)->getRules()->getWorkshops();
-		}
-	}
-	return total;
+	return getCapacity().workshops;
 }
 
 /**
@@ -844,15 +926,7 @@ int Base::getUsedHangars() const
  */
 int Base::getAvailableHangars() const
 {
-	int total = 0;
-	for (std::vector<BaseFacility*>::const_iterator i = _facilities.begin(); i != _facilities.end(); ++i)
-	{
-		if ((*i)->getBuildTime() == 0)
-		{
-			total += (*i)->getRules()->getCrafts();
-		}
-	}
-	return total;
+	return getCapacity().hangars;
 }
 
 /**
@@ -929,15 +1003,7 @@ int Base::getAllocatedEngineers() const
  */
 int Base::getDefenseValue() const
 {
-	int total = 0;
-	for (std::vector<BaseFacility*>::const_iterator i = _facilities.begin(); i != _facilities.end(); ++i)
-	{
-		if ((*i)->getBuildTime() == 0)
-		{
-			total += (*i)->getRules()->getDefenseValue();
-		}
-	}
-	return total;
+	return getCapacity().defense;
 }
 
 /**
@@ -947,18 +1013,7 @@ int Base::getDefenseValue() const
  */
 int Base::getShortRangeDetection() const
 {
-	int total = 0;
-	int minRadarRange = _mod->getMinRadarRange();
-
-	if (minRadarRange == 0) return 0;
-	for (std::vector<BaseFacility*>::const_iterator i = _facilities.begin(); i != _facilities.end(); ++i)
-	{
-		if ((*i)->getRules()->getRadarRange() == minRadarRange && (*i)->getBuildTime() == 0)
-		{
-			total++;
-		}
-	}
-	return total;
+	return getCapacity().shortRangeDetection;
 }
 
 /**
@@ -968,17 +1023,7 @@ int Base::getShortRangeDetection() const
  */
 int Base::getLongRangeDetection() const
 {
-	int total = 0;
-	int minRadarRange = _mod->getMinRadarRange();
-
-	for (std::vector<BaseFacility*>::const_iterator i = _facilities.begin(); i != _facilities.end(); ++i)
-	{
-		if ((*i)->getRules()->getRadarRange() > minRadarRange && (*i)->getBuildTime() == 0)
-		{
-			total++;
-		}
-	}
-	return total;
+	return getCapacity().longRangeDetection;
 }
 
 /**
@@ -1086,15 +1131,7 @@ int Base::getPersonnelMaintenance() const
  */
 int Base::getFacilityMaintenance() const
 {
-	int total = 0;
-	for (std::vector<BaseFacility*>::const_iterator i = _facilities.begin(); i != _facilities.end(); ++i)
-	{
-		if ((*i)->getBuildTime() == 0)
-		{
-			total += (*i)->getRules()->getMonthlyCost();
-		}
-	}
-	return total;
+	return getCapacity().maintenance;
 }
 
 /**
@@ -1189,15 +1226,7 @@ const std::vector<Production *> & Base::getProductions() const
  */
 int Base::getAvailablePsiLabs() const
 {
-	int total = 0;
-	for (std::vector<BaseFacility*>::const_iterator i = _facilities.begin(); i != _facilities.end(); ++i)
-	{
-		if ((*i)->getBuildTime() == 0)
-		{
-			total += (*i)->getRules()->getPsiLaboratories();
-		}
-	}
-	return total;
+	return getCapacity().psiLabs;
 }
 
 /**
@@ -1226,7 +1255,8 @@ int Base::getUsedPsiLabs() const
 int Base::getUsedContainment() const
 {
 	int total = 0;
-	for (std::map<std::string, int>::iterator i = _items->getContents()->begin(); i != _items->getContents()->end(); ++i)
+	const ItemContainer *items = _items;
+	for (std::map<std::string, int>::const_iterator i = items->getContents()->begin(); i != items->getContents()->end(); ++i)
 	{
 		if (_mod->getItem((i)->first, true)->isAlien())
 		{
@@ -1237,7 +1267,7 @@ int Base::getUsedContainment() const
 	{
 		if ((*i)->getType() == TRANSFER_ITEM)
 		{
-			if (_mod->getItem((*i)->getItems(), true)->isAlien())
+			if ((*i)->getItemRules()->isAlien())
 			{
 				total += (*i)->getQuantity();
 			}
@@ -1261,15 +1291,7 @@ int Base::getUsedContainment() const
  */
 int Base::getAvailableContainment() const
 {
-	int total = 0;
-	for (std::vector<BaseFacility*>::const_iterator i = _facilities.begin(); i != _facilities.end(); ++i)
-	{
-		if ((*i)->getBuildTime() == 0)
-		{
-			total += (*i)->getRules()->getAliens();
-		}
-	}
-	return total;
+	return getCapacity().containment;
 }
 
 /**
@@ -1760,6 +1782,7 @@ void Base::destroyFacility(std::vector<BaseFacility*>::iterator facility)
 	}
 	delete *facility;
 	_facilities.erase(facility);
+	invalidateFacilities();
 }
 
 /**
@@ -37,6 +37,16 @@ class SavedGame;
 class ResearchProject;
 class Production;
 class Vehicle;
+class RuleBaseFacility;
+
+/**
+ * Totals of what the finished facilities in a base provide.
+ */
+struct BaseCapacity
+{
+	int quarters, stores, laboratories, workshops, hangars, psiLabs, containment;
+	int defense, shortRangeDetection, longRangeDetection, maintenance;
+};
 
 /**
  * Represents a player base on the globe.
@@ -59,9 +69,20 @@ private:
 	bool _retaliationTarget;
 	std::vector<Vehicle*> _vehicles;
 	std::vector<BaseFacility*> _defenses;
+	mutable std::vector<const RuleBaseFacility*> _radars;
+	mutable double _radarRange;
+	mutable bool _radarFacilities, _radarsValid;
+	mutable BaseCapacity _capacity;
+	mutable bool _capacityValid;
 
 	/// Determines space taken up by ammo clips about to rearm craft.
 	double getIgnoredStores();
+	/// Adds up what the finished facilities provide.
+	BaseCapacity calculateCapacity() const;
+	/// Gets what the finished facilities provide.
+	const BaseCapacity &getCapacity() const;
+	/// Updates the list of the base's radars.
+	void updateRadars() const;
 
 	using Target::load;
 public:
@@ -99,6 +120,8 @@ public:
 	int getEngineers() const;
 	/// Sets the base's engineers.
 	void setEngineers(int engineers);
+	/// Marks the base's facilities as changed.
+	void invalidateFacilities();
 	/// Checks if a target is detected by the base's radar.
 	int detect(Target *target) const;
 	/// Checks if a target is inside the base's radar range.
@@ -132,6 +132,10 @@ int BaseFacility::getBuildTime() const
 void BaseFacility::setBuildTime(int time)
 {
 	_buildTime = time;
+	if (_base)
+	{
+		_base->invalidateFacilities();
+	}
 }
 
 /**
@@ -140,6 +144,10 @@ void BaseFacility::setBuildTime(int time)
 void BaseFacility::build()
 {
 	_buildTime--;
+	if (_base && _buildTime == 0)
+	{
+		_base->invalidateFacilities();
+	}
 }
 
 /**
@@ -960,6 +960,7 @@ void BattleUnit::kneel(bool kneeled)
 {
 	_kneeled = kneeled;
 	_cacheInvalid = true;
+	Tile::touchGeometry();
 }
 
 /**
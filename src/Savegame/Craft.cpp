@@ -699,6 +699,16 @@ void Craft::think()
 	}
 }
 
+/**
+ * Checks if the craft has nowhere to go and isn't
+ * taking off, so thinking doesn't change anything.
+ * @return True if the craft is idle.
+ */
+bool Craft::isIdle() const
+{
+	return _dest == 0 && _takeoff == 0;
+}
+
 /**
  * Checks the condition of all the craft's systems
  * to define its new status (eg. when arriving at base).
@@ -143,6 +143,8 @@ public:
 	bool insideRadarRange(Target *target) const;
 	/// Handles craft logic.
 	void think();
+	/// Checks if the craft is standing still.
+	bool isIdle() const;
 	/// Does a craft full checkup.
 	void checkup();
 	/// Consumes the craft's fuel.
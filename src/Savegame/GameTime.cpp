@@ -136,6 +136,16 @@ TimeTrigger GameTime::advance()
 	return trigger;
 }
 
+/**
+ * Returns how many times the time has to advance
+ * until it triggers a 10 minute (or longer) event.
+ * @return Number of 5 second steps (1-120).
+ */
+int GameTime::getStepsTo10Minutes() const
+{
+	return (60 - _second) / 5 + (9 - _minute % 10) * 12;
+}
+
 /**
  * Returns the current ingame second.
  * @return Second (0-59).
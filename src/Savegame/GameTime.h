@@ -50,6 +50,8 @@ public:
 	YAML::Node save() const;
 	/// Advances the time by 5 seconds.
 	TimeTrigger advance();
+	/// Gets the 5 second steps left until the next 10 minute trigger.
+	int getStepsTo10Minutes() const;
 	/// Gets the ingame second.
 	int getSecond() const;
 	/// Gets the ingame minute.
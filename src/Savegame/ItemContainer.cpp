@@ -19,6 +19,7 @@
 #include "ItemContainer.h"
 #include "../Mod/Mod.h"
 #include "../Mod/RuleItem.h"
+#include <cassert>
 
 namespace OpenXcom
 {
@@ -26,7 +27,7 @@ namespace OpenXcom
 /**
  * Initializes an item container with no contents.
  */
-ItemContainer::ItemContainer()
+ItemContainer::ItemContainer() : _sizeMod(0), _size(0)
 {
 }
 
@@ -44,6 +45,7 @@ ItemContainer::~ItemContainer()
 void ItemContainer::load(const YAML::Node &node)
 {
 	_qty = node.as< std::map<std::string, int> >(_qty);
+	_sizeMod = 0;
 }
 
 /**
@@ -73,6 +75,7 @@ void ItemContainer::addItem(const std::string &id, int qty)
 		_qty[id] = 0;
 	}
 	_qty[id] += qty;
+	_sizeMod = 0;
 }
 
 /**
@@ -94,6 +97,7 @@ void ItemContainer::removeItem(const std::string &id, int qty)
 	{
 		_qty.erase(id);
 	}
+	_sizeMod = 0;
 }
 
 /**
@@ -135,24 +139,52 @@ int ItemContainer::getTotalQuantity() const
 
 /**
  * Returns the total size of the items in the container.
+ * The total is kept until the contents change, since
+ * adding it up means looking up every item's ruleset.
  * @param mod Pointer to mod.
  * @return Total item size.
  */
 double ItemContainer::getTotalSize(const Mod *mod) const
 {
+	if (_sizeMod == mod)
+	{
+#ifndef NDEBUG
+		double total = 0;
+		for (std::map<std::string, int>::const_iterator i = _qty.begin(); i != _qty.end(); ++i)
+		{
+			total += mod->getItem(i->first, true)->getSize() * i->second;
+		}
+		assert(total == _size && "ItemContainer changed without updating its size");
+#endif
+		return _size;
+	}
 	double total = 0;
 	for (std::map<std::string, int>::const_iterator i = _qty.begin(); i != _qty.end(); ++i)
 	{
 		total += mod->getItem(i->first, true)->getSize() * i->second;
 	}
+	_sizeMod = mod;
+	_size = total;
 	return total;
 }
 
 /**
  * Returns all the items currently contained within.
+ * The caller may change them, so the total size is
+ * worked out again next time.
  * @return List of contents.
  */
 std::map<std::string, int> *ItemContainer::getContents()
+{
+	_sizeMod = 0;
+	return &_qty;
+}
+
+/**
+ * Returns all the items currently contained within.
+ * @return List of contents.
+ */
+const std::map<std::string, int> *ItemContainer::getContents() const
 {
 	return &_qty;
 }
@@ -35,6 +35,8 @@ class ItemContainer
 {
 private:
 	std::map<std::string, int> _qty;
+	mutable const Mod *_sizeMod;
+	mutable double _size;
 public:
 	/// Creates an empty item container.
 	ItemContainer();
@@ -56,6 +58,8 @@ public:
 	double getTotalSize(const Mod *mod) const;
 	/// Gets all the items in the container.
 	std::map<std::string, int> *getContents();
+	/// Gets all the items in the container (read-only).
+	const std::map<std::string, int> *getContents() const;
 };
 
 }
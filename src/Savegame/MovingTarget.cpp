@@ -17,13 +17,47 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "MovingTarget.h"
+#include <algorithm>
+#include <vector>
 #include "../fmath.h"
+#include "../Geoscape/Cord.h"
 #include "SerializationHelper.h"
 #include "../Engine/Options.h"
 
 namespace OpenXcom
 {
 
+namespace
+{
+
+/**
+ * Gets the dot product of two vectors.
+ * @param a First vector.
+ * @param b Second vector.
+ * @return Dot product.
+ */
+inline double dot(const Cord &a, const Cord &b)
+{
+	return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+/**
+ * Checks if an interceptor can reach a target that has covered
+ * an angle along its path, before the target gets there.
+ * @param a Cosine of the angle between the interceptor and the target's start.
+ * @param b Cosine of the angle between the interceptor and the target's heading.
+ * @param path Angle covered by the target.
+ * @param speedRatio Interceptor speed over target speed.
+ * @return True if the interceptor is there in time.
+ */
+inline bool meetingReached(double a, double b, double path, double speedRatio)
+{
+	double distance = acos(Clamp(a * cos(path) + b * sin(path), -1.0, 1.0));
+	return distance - path * speedRatio <= 0 || path >= M_PI || path * speedRatio >= 1;
+}
+
+}
+
 /**
  * Initializes a moving target with blank coordinates.
  */
@@ -260,40 +294,76 @@ void MovingTarget::calculateMeetPoint()
 	if (!t || !t->getDestination()) return;
 
 	// Speed ratio
-	if (AreSame(t->getSpeedRadian(), 0.0)) return;
+	if (AreSame(t->getSpeedRadian(), 0.0) || AreSame(_speedRadian, 0.0)) return;
 	const double speedRatio = _speedRadian/ t->getSpeedRadian();
 
-	// The direction pseudovector
-	double	nx = cos(t->getLatitude())*sin(t->getLongitude())*sin(t->getDestination()->getLatitude()) -
-					sin(t->getLatitude())*cos(t->getDestination()->getLatitude())*sin(t->getDestination()->getLongitude()),
-			ny = sin(t->getLatitude())*cos(t->getDestination()->getLatitude())*cos(t->getDestination()->getLongitude()) -
-					cos(t->getLatitude())*cos(t->getLongitude())*sin(t->getDestination()->getLatitude()),
-			nz = cos(t->getLatitude())*cos(t->getDestination()->getLatitude())*sin(t->getDestination()->getLongitude() - t->getLongitude());
-	// Normalize and multiplex with radian speed
-	double	nk = _speedRadian/sqrt(nx*nx+ny*ny+nz*nz);
-	nx *= nk;
-	ny *= nk;
-	nz *= nk;
-
-	// Finding the meeting point. Don't search further than halfway across the
-	// globe (distance from interceptor's current point >= 1), as that may
-	// cause the interceptor to go the wrong way later.
-	for (double path = 0, distance = 1;
-		path < M_PI && distance - path*speedRatio > 0 && path*speedRatio < 1;
-		path += _speedRadian)
+	// The target moves along a great circle: after covering an angle s,
+	// it's at start * cos(s) + heading * sin(s), so the interceptor's
+	// distance to it is acos(a * cos(s) + b * sin(s)).
+	Cord start(CordPolar(t->getLongitude(), t->getLatitude()));
+	Cord heading(CordPolar(t->getDestination()->getLongitude(), t->getDestination()->getLatitude()));
+	Cord interceptor(CordPolar(_lon, _lat));
+	double along = dot(start, heading);
+	heading -= Cord(start.x * along, start.y * along, start.z * along);
+	if (heading.norm() < 1e-9) return;
+	heading /= heading.norm();
+	const double a = dot(interceptor, start), b = dot(interceptor, heading);
+
+	// The meeting point is where the target is after the first whole number
+	// of steps (of the interceptor's speed) that lets the interceptor get
+	// there first. Don't search further than halfway across the globe
+	// (distance from interceptor's current point >= 1), as that may cause
+	// the interceptor to go the wrong way later.
+	const int lastStep = std::max(1, (int)ceil(std::min(M_PI, 1 / speedRatio) / _speedRadian));
+
+	// Split the path where the gap between target and interceptor
+	// changes from shrinking to growing or back, so each part can be
+	// searched with bisection.
+	std::vector<double> breaks;
+	breaks.push_back(0);
+	const double range = sqrt(a * a + b * b), phase = atan2(b, a);
+	if (range > speedRatio && speedRatio < 1)
 	{
-		_meetPointLat += nx*sin(_meetPointLon) - ny*cos(_meetPointLon);
-		if (std::abs(_meetPointLat) < M_PI_2) _meetPointLon += nz - (nx*cos(_meetPointLon) + ny*sin(_meetPointLon))*tan(_meetPointLat); else _meetPointLon += M_PI;
+		double turn = acos(sqrt((range * range - speedRatio * speedRatio) / (range * range * (1 - speedRatio * speedRatio))));
+		double turns[] = { phase + turn, phase + M_PI - turn };
+		for (int i = 0; i < 2; ++i)
+		{
+			double s = fmod(turns[i], 2 * M_PI);
+			if (s < 0) s += 2 * M_PI;
+			if (s < lastStep * _speedRadian) breaks.push_back(s);
+		}
+		std::sort(breaks.begin(), breaks.end());
+	}
+	breaks.push_back(lastStep * _speedRadian);
 
-		distance = acos(cos(_lat) * cos(_meetPointLat) * cos(_meetPointLon - _lon) + sin(_lat) * sin(_meetPointLat));
+	int step = lastStep;
+	for (size_t i = 0; i + 1 < breaks.size() && step == lastStep; ++i)
+	{
+		int first = std::max(1, (int)ceil(breaks[i] / _speedRadian));
+		int last = std::min(lastStep, (int)floor(breaks[i + 1] / _speedRadian));
+		if (first > last) continue;
+		if (meetingReached(a, b, first * _speedRadian, speedRatio))
+		{
+			step = first;
+		}
+		else if (meetingReached(a, b, last * _speedRadian, speedRatio))
+		{
+			while (last - first > 1)
+			{
+				int middle = first + (last - first) / 2;
+				if (meetingReached(a, b, middle * _speedRadian, speedRatio))
+					last = middle;
+				else
+					first = middle;
+			}
+			step = last;
+		}
 	}
 
-	// Correction overflowing angles
-	double lonSign = Sign(_meetPointLon);
-	double latSign = Sign(_meetPointLat);
-	while (std::abs(_meetPointLon) > M_PI) _meetPointLon -= lonSign * 2 * M_PI;
-	while (std::abs(_meetPointLat) > M_PI) _meetPointLat -= latSign * 2 * M_PI;
-	if (std::abs(_meetPointLat) > M_PI_2) { _meetPointLat = latSign * std::abs(2 * M_PI - std::abs(_meetPointLat)); _meetPointLon -= lonSign * M_PI; }
+	double s = step * _speedRadian;
+	CordPolar meet(Cord(start.x * cos(s) + heading.x * sin(s), start.y * cos(s) + heading.y * sin(s), start.z * cos(s) + heading.z * sin(s)));
+	_meetPointLon = meet.lon;
+	_meetPointLat = meet.lat;
 
 	_meetCalculated = true;
 }
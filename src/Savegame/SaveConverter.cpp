@@ -748,6 +748,7 @@ void SaveConverter::loadDatBase()
 					facility->setY(y);
 					facility->setBuildTime(days);
 					base->getFacilities()->push_back(facility);
+					base->invalidateFacilities();
 				}
 			}
 			int engineers = load<Uint8>(bdata + _rules->getOffset("BASE.DAT_ENGINEERS"));
@@ -858,9 +859,9 @@ void SaveConverter::loadDatTransfer()
 				break;
 			default:
 				if (type == TRANSFER_ITEM)
-					transfer->setItems(_rules->getItems()[dat], qty);
+					transfer->setItems(_mod->getItem(_rules->getItems()[dat], true), qty);
 				else
-					transfer->setItems(_aliens[dat]);
+					transfer->setItems(_mod->getItem(_aliens[dat], true));
 				break;
 			}
 
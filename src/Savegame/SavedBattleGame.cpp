@@ -17,7 +17,10 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <assert.h>
+#include <string.h>
 #include <vector>
+#include <algorithm>
+#include <new>
 #include "BattleItem.h"
 #include "SavedBattleGame.h"
 #include "SavedGame.h"
@@ -38,16 +41,48 @@
 #include "../Engine/RNG.h"
 #include "../Engine/Options.h"
 #include "../Engine/Logger.h"
+#include "../Engine/Exception.h"
 #include "SerializationHelper.h"
 #include "../Mod/RuleItem.h"
 
 namespace OpenXcom
 {
 
+namespace
+{
+
+/// Bytes of tile data after which a new chunk is started.
+const size_t TILE_CHUNK_SIZE = 64 * 1024;
+/// Most tiles a single run can hold.
+const int TILE_RUN_MAX = 0x7FFF;
+
+/// Types of runs in a tile chunk.
+enum TileRunType { TILE_RUN_LIST, TILE_RUN_REPEAT };
+
+/**
+ * Checks if a tile would be saved as the same binary data.
+ * @param tile Pointer to the tile.
+ * @param data Binary data to compare with.
+ * @param buffer Scratch space for the tile's data.
+ * @return True if the tile isn't void and matches the data.
+ */
+bool tileMatches(const Tile *tile, const std::vector<Uint8> &data, std::vector<Uint8> &buffer)
+{
+	if (tile->isVoid())
+	{
+		return false;
+	}
+	Uint8 *w = &buffer[0];
+	tile->saveBinary(&w);
+	return memcmp(&buffer[0], &data[0], data.size()) == 0;
+}
+
+}
+
 /**
  * Initializes a brand new battlescape saved game.
  */
-SavedBattleGame::SavedBattleGame() : _battleState(0), _mapsize_x(0), _mapsize_y(0), _mapsize_z(0), _selectedUnit(0), _lastSelectedUnit(0), _pathfinding(0), _tileEngine(0), _globalShade(0),
+SavedBattleGame::SavedBattleGame() : _battleState(0), _mapsize_x(0), _mapsize_y(0), _mapsize_z(0), _tileStore(0), _tiles(0), _selectedUnit(0), _lastSelectedUnit(0), _pathfinding(0), _tileEngine(0), _globalShade(0),
 	_side(FACTION_PLAYER), _turn(1), _debugMode(false), _aborted(false), _itemId(0), _objectiveType(-1), _objectivesDestroyed(0), _objectivesNeeded(0), _unitsFalling(false), _cheating(false),
 	_tuReserved(BA_NONE), _kneelReserved(false), _depth(0), _ambience(-1), _ambientVolume(0.5), _turnLimit(0), _cheatTurn(20), _chronoTrigger(FORCE_LOSE), _beforeGame(true)
 {
@@ -64,18 +99,11 @@ SavedBattleGame::SavedBattleGame() : _battleState(0), _mapsize_x(0), _mapsize_y(
  */
 SavedBattleGame::~SavedBattleGame()
 {
-	if (_mapsize_z * _mapsize_y * _mapsize_x > 0)
-	{
-		for (int i = 0; i < _mapsize_z * _mapsize_y * _mapsize_x; ++i)
-		{
-			delete _tiles[i];
-		}
-		delete[] _tiles;
-	}
+	deleteTiles();
 
 	for (std::vector<MapDataSet*>::iterator i = _mapDataSets.begin(); i != _mapDataSets.end(); ++i)
 	{
-		(*i)->unloadData();
+		(*i)->release();
 	}
 
 	for (std::vector<Node*>::iterator i = _nodes.begin(); i != _nodes.end(); ++i)
@@ -159,18 +187,57 @@ void SavedBattleGame::load(const YAML::Node &node, Mod *mod, SavedGame* savedGam
 		serKey._mapDataSetID = node["tileSetIDSize"].as<char>(serKey._mapDataSetID);
 		serKey.boolFields = node["tileBoolFieldsSize"].as<char>(1); // boolean flags used to be stored in an unmentioned byte (Uint8) :|
 
-		// load binary tile data!
-		YAML::Binary binTiles = node["binTiles"].as<YAML::Binary>();
+		if (node["binTiles"])
+		{
+			// load binary tile data!
+			YAML::Binary binTiles = node["binTiles"].as<YAML::Binary>();
 
-		Uint8 *r = (Uint8*)binTiles.data();
-		Uint8 *dataEnd = r + totalTiles * serKey.totalBytes;
+			Uint8 *r = (Uint8*)binTiles.data();
+			Uint8 *dataEnd = r + totalTiles * serKey.totalBytes;
 
-		while (r < dataEnd)
+			while (r < dataEnd)
+			{
+				int index = unserializeInt(&r, serKey.index);
+				assert (index >= 0 && index < _mapsize_x * _mapsize_z * _mapsize_y);
+				_tiles[index]->loadBinary(r, serKey); // loadBinary's privileges to advance *r have been revoked
+				r += serKey.totalBytes-serKey.index; // r is now incremented strictly by totalBytes in case there are obsolete fields present in the data
+			}
+		}
+		else
 		{
-			int index = unserializeInt(&r, serKey.index);
-			assert (index >= 0 && index < _mapsize_x * _mapsize_z * _mapsize_y);
-			_tiles[index]->loadBinary(r, serKey); // loadBinary's privileges to advance *r have been revoked
-			r += serKey.totalBytes-serKey.index; // r is now incremented strictly by totalBytes in case there are obsolete fields present in the data
+			// load run-length encoded tile data, one chunk at a time
+			const size_t recordSize = serKey.totalBytes - serKey.index;
+			const size_t headerSize = serKey.index + 2 + 1;
+			const int mapSize = _mapsize_x * _mapsize_z * _mapsize_y;
+			for (YAML::const_iterator i = node["tileChunks"].begin(); i != node["tileChunks"].end(); ++i)
+			{
+				YAML::Binary chunk = i->as<YAML::Binary>();
+				Uint8 *r = (Uint8*)chunk.data();
+				Uint8 *dataEnd = r + chunk.size();
+				while (r + headerSize <= dataEnd)
+				{
+					int index = unserializeInt(&r, serKey.index);
+					int count = unserializeInt(&r, 2);
+					int type = unserializeInt(&r, 1);
+					size_t runSize = (type == TILE_RUN_REPEAT) ? recordSize : recordSize * count;
+					if (index < 0 || count <= 0 || index + count > mapSize || r + runSize > dataEnd)
+					{
+						throw Exception("Invalid tile data in saved battle");
+					}
+					for (int j = index; j < index + count; ++j)
+					{
+						_tiles[j]->loadBinary(r, serKey); // loadBinary's privileges to advance *r have been revoked
+						if (type != TILE_RUN_REPEAT)
+						{
+							r += recordSize;
+						}
+					}
+					if (type == TILE_RUN_REPEAT)
+					{
+						r += recordSize;
+					}
+				}
+			}
 		}
 	}
 	if (_missionType == "STR_BASE_DEFENSE")
@@ -421,25 +488,70 @@ YAML::Node SavedBattleGame::save() const
 	node["tileSetIDSize"] = static_cast<char>(Tile::serializationKey._mapDataSetID);
 	node["tileBoolFieldsSize"] = static_cast<char>(Tile::serializationKey.boolFields);
 
-	size_t tileDataSize = Tile::serializationKey.totalBytes * _mapsize_z * _mapsize_y * _mapsize_x;
-	Uint8* tileData = (Uint8*) calloc(tileDataSize, 1);
-	Uint8* w = tileData;
-
-	for (int i = 0; i < _mapsize_z * _mapsize_y * _mapsize_x; ++i)
-	{
-		if (!_tiles[i]->isVoid())
+	// then the tiles, as runs of consecutive non-void tiles split in chunks:
+	// each run starts with the index of its first tile, the tile count and
+	// the run type, followed by the data of every tile, or by the data of
+	// a single tile if they're all the same. Void tiles aren't stored.
+	const size_t recordSize = Tile::serializationKey.totalBytes - Tile::serializationKey.index;
+	const size_t headerSize = Tile::serializationKey.index + 2 + 1;
+	const int mapSize = _mapsize_z * _mapsize_y * _mapsize_x;
+	std::vector<Uint8> chunk, record(recordSize), buffer(recordSize);
+	chunk.reserve(TILE_CHUNK_SIZE + headerSize + recordSize);
+	size_t totalTiles = 0;
+
+	int i = 0;
+	while (i < mapSize)
+	{
+		if (_tiles[i]->isVoid())
+		{
+			++i;
+			continue;
+		}
+		size_t header = chunk.size();
+		chunk.resize(header + headerSize);
+		Uint8 *w = &record[0];
+		_tiles[i]->saveBinary(&w);
+		chunk.insert(chunk.end(), record.begin(), record.end());
+
+		int count = 1;
+		while (i + count < mapSize && count < TILE_RUN_MAX && tileMatches(_tiles[i + count], record, buffer))
 		{
-			serializeInt(&w, Tile::serializationKey.index, i);
-			_tiles[i]->saveBinary(&w);
+			++count;
 		}
-		else
+		TileRunType type = (count > 1) ? TILE_RUN_REPEAT : TILE_RUN_LIST;
+		if (type == TILE_RUN_LIST)
+		{
+			// stop the list before a void tile or a repeat
+			while (i + count < mapSize && count < TILE_RUN_MAX && chunk.size() < TILE_CHUNK_SIZE && !_tiles[i + count]->isVoid())
+			{
+				w = &record[0];
+				_tiles[i + count]->saveBinary(&w);
+				if (i + count + 1 < mapSize && tileMatches(_tiles[i + count + 1], record, buffer))
+				{
+					break;
+				}
+				chunk.insert(chunk.end(), record.begin(), record.end());
+				++count;
+			}
+		}
+		w = &chunk[header];
+		serializeInt(&w, Tile::serializationKey.index, i);
+		serializeInt(&w, 2, count);
+		serializeInt(&w, 1, type);
+		totalTiles += count;
+		i += count;
+
+		if (chunk.size() >= TILE_CHUNK_SIZE)
 		{
-			tileDataSize -= Tile::serializationKey.totalBytes;
+			node["tileChunks"].push_back(YAML::Binary(&chunk[0], chunk.size()));
+			chunk.clear();
 		}
 	}
-	node["totalTiles"] = tileDataSize / Tile::serializationKey.totalBytes; // not strictly necessary, just convenient
-	node["binTiles"] = YAML::Binary(tileData, tileDataSize);
-	free(tileData);
+	if (!chunk.empty())
+	{
+		node["tileChunks"].push_back(YAML::Binary(&chunk[0], chunk.size()));
+	}
+	node["totalTiles"] = totalTiles; // not strictly necessary, just convenient
 #endif
 	for (std::vector<Node*>::const_iterator i = _nodes.begin(); i != _nodes.end(); ++i)
 	{
@@ -496,14 +608,7 @@ Tile **SavedBattleGame::getTiles() const
 void SavedBattleGame::initMap(int mapsize_x, int mapsize_y, int mapsize_z, bool resetTerrain)
 {
 	// Clear old map data
-	if (_mapsize_z * _mapsize_y * _mapsize_x > 0)
-	{
-		for (int i = 0; i < _mapsize_z * _mapsize_y * _mapsize_x; ++i)
-		{
-			delete _tiles[i];
-		}
-		delete[] _tiles;
-	}
+	deleteTiles();
 
 	for (std::vector<Node*>::iterator i = _nodes.begin(); i != _nodes.end(); ++i)
 	{
@@ -513,6 +618,10 @@ void SavedBattleGame::initMap(int mapsize_x, int mapsize_y, int mapsize_z, bool
 
 	if (resetTerrain)
 	{
+		for (std::vector<MapDataSet*>::iterator i = _mapDataSets.begin(); i != _mapDataSets.end(); ++i)
+		{
+			(*i)->release();
+		}
 		_mapDataSets.clear();
 	}
 
@@ -520,16 +629,39 @@ void SavedBattleGame::initMap(int mapsize_x, int mapsize_y, int mapsize_z, bool
 	_mapsize_x = mapsize_x;
 	_mapsize_y = mapsize_y;
 	_mapsize_z = mapsize_z;
-	_tiles = new Tile*[_mapsize_z * _mapsize_y * _mapsize_x];
-	for (int i = 0; i < _mapsize_z * _mapsize_y * _mapsize_x; ++i)
+	// all the tiles live in one block in index order, so sweeps over
+	// the map walk through memory instead of chasing pointers
+	int size = _mapsize_z * _mapsize_y * _mapsize_x;
+	_tileStore = static_cast<Tile*>(::operator new(sizeof(Tile) * size));
+	_tiles = new Tile*[size];
+	for (int i = 0; i < size; ++i)
 	{
 		Position pos;
 		getTileCoords(i, &pos.x, &pos.y, &pos.z);
-		_tiles[i] = new Tile(pos);
+		_tiles[i] = new (&_tileStore[i]) Tile(pos, &_activeTiles);
 	}
 
 }
 
+/**
+ * Destroys the tiles of the current map and frees their storage.
+ */
+void SavedBattleGame::deleteTiles()
+{
+	if (_tileStore)
+	{
+		for (int i = 0; i < _mapsize_z * _mapsize_y * _mapsize_x; ++i)
+		{
+			_tileStore[i].~Tile();
+		}
+		::operator delete(_tileStore);
+		_tileStore = 0;
+	}
+	delete[] _tiles;
+	_tiles = 0;
+	_activeTiles.clear();
+}
+
 /**
  * Initializes the map utilities.
  * @param mod Pointer to mod.
@@ -1368,12 +1500,17 @@ void SavedBattleGame::prepareNewTurn()
 	std::vector<Tile*> tilesOnFire;
 	std::vector<Tile*> tilesOnSmoke;
 
+	// only tiles with fire, smoke or danger are on the active list. they all live
+	// in one block in map order, so sorting the pointers visits them the same way
+	// a sweep over the whole map would.
+	std::sort(_activeTiles.begin(), _activeTiles.end());
+
 	// prepare a list of tiles on fire
-	for (int i = 0; i < _mapsize_x * _mapsize_y * _mapsize_z; ++i)
+	for (std::vector<Tile*>::iterator i = _activeTiles.begin(); i != _activeTiles.end(); ++i)
 	{
-		if (getTiles()[i]->getFire() > 0)
+		if ((*i)->getFire() > 0)
 		{
-			tilesOnFire.push_back(getTiles()[i]);
+			tilesOnFire.push_back(*i);
 		}
 	}
 
@@ -1438,13 +1575,14 @@ void SavedBattleGame::prepareNewTurn()
 	}
 
 	// prepare a list of tiles on fire/with smoke in them (smoke acts as fire intensity)
-	for (int i = 0; i < _mapsize_x * _mapsize_y * _mapsize_z; ++i)
+	std::sort(_activeTiles.begin(), _activeTiles.end());
+	for (std::vector<Tile*>::iterator i = _activeTiles.begin(); i != _activeTiles.end(); ++i)
 	{
-		if (getTiles()[i]->getSmoke() > 0)
+		if ((*i)->getSmoke() > 0)
 		{
-			tilesOnSmoke.push_back(getTiles()[i]);
+			tilesOnSmoke.push_back(*i);
 		}
-		getTiles()[i]->setDangerous(false);
+		(*i)->setDangerous(false);
 	}
 
 	// now make the smoke spread.
@@ -1502,15 +1640,31 @@ void SavedBattleGame::prepareNewTurn()
 	if (!tilesOnFire.empty() || !tilesOnSmoke.empty())
 	{
 		// do damage to units, average out the smoke, etc.
-		for (int i = 0; i < _mapsize_x * _mapsize_y * _mapsize_z; ++i)
+		std::sort(_activeTiles.begin(), _activeTiles.end());
+		for (size_t i = 0; i < _activeTiles.size(); ++i)
 		{
-			if (getTiles()[i]->getSmoke() != 0)
-				getTiles()[i]->prepareNewTurn(getDepth() == 0);
+			if (_activeTiles[i]->getSmoke() != 0)
+				_activeTiles[i]->prepareNewTurn(getDepth() == 0);
 		}
 		// fires could have been started, stopped or smoke could reveal/conceal units.
 		getTileEngine()->calculateTerrainLighting();
 	}
 
+	// drop the tiles that have burnt out and cleared up
+	std::vector<Tile*>::iterator last = _activeTiles.begin();
+	for (std::vector<Tile*>::iterator i = _activeTiles.begin(); i != _activeTiles.end(); ++i)
+	{
+		if ((*i)->isActive())
+		{
+			*last++ = *i;
+		}
+		else
+		{
+			(*i)->deactivate();
+		}
+	}
+	_activeTiles.erase(last, _activeTiles.end());
+
 	reviveUnconsciousUnits();
 }
 
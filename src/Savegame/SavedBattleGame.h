@@ -50,7 +50,9 @@ private:
 	BattlescapeState *_battleState;
 	int _mapsize_x, _mapsize_y, _mapsize_z;
 	std::vector<MapDataSet*> _mapDataSets;
+	Tile *_tileStore;
 	Tile **_tiles;
+	std::vector<Tile*> _activeTiles;
 	BattleUnit *_selectedUnit, *_lastSelectedUnit;
 	std::vector<Node*> _nodes;
 	std::vector<BattleUnit*> _units;
@@ -81,6 +83,8 @@ private:
 	bool _beforeGame;
 	/// Selects a soldier.
 	BattleUnit *selectPlayerUnit(int dir, bool checkReselect = false, bool setReselect = false, bool checkInventory = false);
+	/// Deletes the tiles of the map.
+	void deleteTiles();
 public:
 	/// Creates a new battle save, based on the current generic save.
 	SavedBattleGame();
@@ -356,7 +356,14 @@ void SavedGame::load(const std::string &filename, Mod *mod)
 	_difficulty = (GameDifficulty)doc["difficulty"].as<int>(_difficulty);
 	_end = (GameEnding)doc["end"].as<int>(_end);
 	if (doc["rng"] && (_ironman || !Options::newSeedOnLoad))
+	{
 		RNG::setSeed(doc["rng"].as<uint64_t>());
+		std::vector<uint64_t> streams = doc["rngStreams"].as<std::vector<uint64_t> >(std::vector<uint64_t>());
+		for (size_t i = 0; i < streams.size() && i < RNG::STREAM_COUNT; ++i)
+		{
+			RNG::getStream((RNG::RandomStream)i).setSeed(streams[i]);
+		}
+	}
 	_monthsPassed = doc["monthsPassed"].as<int>(_monthsPassed);
 	_graphRegionToggles = doc["graphRegionToggles"].as<std::string>(_graphRegionToggles);
 	_graphCountryToggles = doc["graphCountryToggles"].as<std::string>(_graphCountryToggles);
@@ -497,7 +504,7 @@ void SavedGame::load(const std::string &filename, Mod *mod)
 		std::string research = it->as<std::string>();
 		if (mod->getResearch(research))
 		{
-			_discovered.push_back(mod->getResearch(research));
+			addDiscovered(mod->getResearch(research));
 		}
 		else
 		{
@@ -610,7 +617,11 @@ void SavedGame::save(const std::string &filename) const
 	node["graphRegionToggles"] = _graphRegionToggles;
 	node["graphCountryToggles"] = _graphCountryToggles;
 	node["graphFinanceToggles"] = _graphFinanceToggles;
-	node["rng"] = RNG::getSeed();
+	node["rng"] = RNG::getStream(RNG::STREAM_GEOSCAPE).getSeed();
+	for (int i = 0; i < RNG::STREAM_COUNT; ++i)
+	{
+		node["rngStreams"].push_back(RNG::getStream((RNG::RandomStream)i).getSeed());
+	}
 	node["funds"] = _funds;
 	node["maintenance"] = _maintenance;
 	node["researchScores"] = _researchScores;
@@ -1106,8 +1117,24 @@ void SavedGame::setBattleGame(SavedBattleGame *battleGame)
  * @param research The newly found ResearchProject
  */
 void SavedGame::addFinishedResearchSimple(const RuleResearch * research)
+{
+	addDiscovered(research);
+}
+
+/**
+ * Adds a research topic to the list of discovered topics
+ * and flags its handle as researched.
+ * @param research The discovered research.
+ */
+void SavedGame::addDiscovered(const RuleResearch * research)
 {
 	_discovered.push_back(research);
+	size_t index = research->getIndex();
+	if (index >= _researched.size())
+	{
+		_researched.resize(index + 1, false);
+	}
+	_researched[index] = true;
 }
 
 /**
@@ -1133,10 +1160,10 @@ void SavedGame::addFinishedResearch(const RuleResearch * research, const Mod * m
 
 		// 2. If the currentQueueItem was *not* already discovered before, add it to discovered research
 		bool checkRelatedZeroCostTopics = true;
-		if (!isResearched(currentQueueItem->getName(), false))
+		if (!isResearched(currentQueueItem, false))
 		{
-			_discovered.push_back(currentQueueItem);
-			if (!hasUndiscoveredProtectedUnlocks && isResearched(currentQueueItem->getGetOneFree(), false))
+			addDiscovered(currentQueueItem);
+			if (!hasUndiscoveredProtectedUnlocks && isResearched(currentQueueItem->getGetOneFreeRules(), false))
 			{
 				// If the currentQueueItem can't tell you anything anymore, remove it from popped research
 				// Note: this is for optimisation purposes only, functionally it is *not* required...
@@ -1188,7 +1215,7 @@ void SavedGame::addFinishedResearch(const RuleResearch * research, const Mod * m
 					bool isAlreadyInTheQueue = false;
 					for (std::vector<const RuleResearch *>::const_iterator itQueue = queue.begin(); itQueue != queue.end(); ++itQueue)
 					{
-						if ((*itQueue)->getName() == (*itProjectToTest)->getName())
+						if ((*itQueue) == (*itProjectToTest))
 						{
 							isAlreadyInTheQueue = true;
 							break;
@@ -1205,9 +1232,9 @@ void SavedGame::addFinishedResearch(const RuleResearch * research, const Mod * m
 						else
 						{
 							// for "protected" topics, we need to check if the currentQueueItem can unlock it or not
-							for (std::vector<std::string>::const_iterator itUnlocks = currentQueueItem->getUnlocked().begin(); itUnlocks != currentQueueItem->getUnlocked().end(); ++itUnlocks)
+							for (std::vector<const RuleResearch *>::const_iterator itUnlocks = currentQueueItem->getUnlockRules().begin(); itUnlocks != currentQueueItem->getUnlockRules().end(); ++itUnlocks)
 							{
-								if ((*itProjectToTest)->getName() == (*itUnlocks))
+								if ((*itProjectToTest) == (*itUnlocks))
 								{
 									queue.push_back((*itProjectToTest));
 									break;
@@ -1244,12 +1271,15 @@ void SavedGame::getAvailableResearchProjects(std::vector<RuleResearch *> & proje
 {
 	// This list is used for topics that can be researched even if *not all* dependencies have been discovered yet (e.g. STR_ALIEN_ORIGINS)
 	// Note: all requirements of such topics *have to* be discovered though! This will be handled elsewhere.
-	std::vector<const RuleResearch *> unlocked;
+	std::vector<bool> unlocked(mod->getResearchList().size(), false);
 	for (std::vector<const RuleResearch *>::const_iterator it = _discovered.begin(); it != _discovered.end(); ++it)
 	{
-		for (std::vector<std::string>::const_iterator itUnlocked = (*it)->getUnlocked().begin(); itUnlocked != (*it)->getUnlocked().end(); ++itUnlocked)
+		const std::vector<const RuleResearch *> &unlocks = (*it)->getUnlockRules();
+		for (size_t i = 0; i < unlocks.size(); ++i)
 		{
-			unlocked.push_back(mod->getResearch(*itUnlocked, true));
+			// unknown unlocks only fail once they're reached
+			const RuleResearch *unlock = unlocks[i] ? unlocks[i] : mod->getResearch((*it)->getUnlocked()[i], true);
+			unlocked[unlock->getIndex()] = true;
 		}
 	}
 
@@ -1258,14 +1288,14 @@ void SavedGame::getAvailableResearchProjects(std::vector<RuleResearch *> & proje
 	{
 		RuleResearch *research = mod->getResearch(*iter);
 
-		if ((considerDebugMode && _debug) || std::find(unlocked.begin(), unlocked.end(), research) != unlocked.end())
+		if ((considerDebugMode && _debug) || unlocked[research->getIndex()])
 		{
 			// Empty, these research topics are on the "unlocked list", *don't* check the dependencies!
 		}
 		else
 		{
 			// These items are not on the "unlocked list", we must check if "dependencies" are satisfied!
-			if (!isResearched(research->getDependencies(), considerDebugMode))
+			if (!isResearched(research->getDependencyRules(), considerDebugMode))
 			{
 				continue;
 			}
@@ -1277,15 +1307,15 @@ void SavedGame::getAvailableResearchProjects(std::vector<RuleResearch *> & proje
 		//   - there is an additional filter in NewPossibleResearchState::NewPossibleResearchState()
 		//   - we do this check for other functionality using this method, namely SavedGame::addFinishedResearch()
 		//     - Note: when called from there, parameter considerDebugMode = false
-		if (!isResearched(research->getRequirements(), considerDebugMode))
+		if (!isResearched(research->getRequirementRules(), considerDebugMode))
 		{
 			continue;
 		}
 
 		// Remove the already researched topics from the list *UNLESS* they can still give you something more
-		if (isResearched(research->getName(), false))
+		if (isResearched(research, false))
 		{
-			if (!isResearched(research->getGetOneFree(), false))
+			if (!isResearched(research->getGetOneFreeRules(), false))
 			{
 				// This research topic still has some more undiscovered "getOneFree" topics, keep it!
 			}
@@ -1368,7 +1398,7 @@ void SavedGame::getAvailableProductions (std::vector<RuleManufacture *> & produc
 		++iter)
 	{
 		RuleManufacture *m = mod->getManufacture(*iter);
-		if (!isResearched(m->getRequirements()))
+		if (!isResearched(m->getRequirementRules()))
 		{
 			continue;
 		}
@@ -1387,16 +1417,15 @@ void SavedGame::getAvailableProductions (std::vector<RuleManufacture *> & produc
  * @param mod the Game Mod
  * @param base a pointer to a Base
  */
-void SavedGame::getDependableManufacture (std::vector<RuleManufacture *> & dependables, const RuleResearch *research, const Mod * mod, Base *) const
+void SavedGame::getDependableManufacture (std::vector<RuleManufacture *> & dependables, const RuleResearch *research, const Mod *, Base *) const
 {
-	const std::vector<std::string> &mans = mod->getManufactureList();
-	for (std::vector<std::string>::const_iterator iter = mans.begin(); iter != mans.end(); ++iter)
+	// Only the projects requiring this research can have become available
+	const std::vector<RuleManufacture *> &mans = research->getDependentManufacture();
+	for (std::vector<RuleManufacture *>::const_iterator iter = mans.begin(); iter != mans.end(); ++iter)
 	{
-		RuleManufacture *m = mod->getManufacture(*iter);
-		const std::vector<std::string> &reqs = m->getRequirements();
-		if (isResearched(m->getRequirements()) && std::find(reqs.begin(), reqs.end(), research->getName()) != reqs.end())
+		if (isResearched((*iter)->getRequirementRules()))
 		{
-			dependables.push_back(m);
+			dependables.push_back(*iter);
 		}
 	}
 }
@@ -1410,12 +1439,13 @@ void SavedGame::getDependableManufacture (std::vector<RuleManufacture *> & depen
 bool SavedGame::hasUndiscoveredProtectedUnlock(const RuleResearch * r, const Mod * mod) const
 {
 	// Note: checking for not yet discovered unlocks protected by "requires" (which also implies cost = 0)
-	for (std::vector<std::string>::const_iterator itUnlocked = r->getUnlocked().begin(); itUnlocked != r->getUnlocked().end(); ++itUnlocked)
+	const std::vector<const RuleResearch *> &unlocks = r->getUnlockRules();
+	for (size_t i = 0; i < unlocks.size(); ++i)
 	{
-		RuleResearch *unlock = mod->getResearch(*itUnlocked, true);
+		const RuleResearch *unlock = unlocks[i] ? unlocks[i] : mod->getResearch(r->getUnlocked()[i], true);
 		if (!unlock->getRequirements().empty())
 		{
-			if (!isResearched(unlock->getName(), false))
+			if (!isResearched(unlock, false))
 			{
 				return true;
 			}
@@ -1445,6 +1475,21 @@ bool SavedGame::isResearched(const std::string &research, bool considerDebugMode
 	return false;
 }
 
+/**
+ * Returns if a certain research topic has been completed.
+ * Looks up the research handle directly instead of comparing names.
+ * @param research Research rule.
+ * @param considerDebugMode Should debug mode be considered or not.
+ * @return Whether it's researched or not.
+ */
+bool SavedGame::isResearched(const RuleResearch *research, bool considerDebugMode) const
+{
+	if (considerDebugMode && _debug)
+		return true;
+	size_t index = research->getIndex();
+	return index < _researched.size() && _researched[index];
+}
+
 /**
  * Returns if a certain list of research topics has been completed.
  * @param research List of research IDs.
@@ -1457,22 +1502,32 @@ bool SavedGame::isResearched(const std::vector<std::string> &research, bool cons
 		return true;
 	if (considerDebugMode && _debug)
 		return true;
-	std::vector<std::string> matches = research;
-	for (std::vector<const RuleResearch *>::const_iterator i = _discovered.begin(); i != _discovered.end(); ++i)
+	for (std::vector<std::string>::const_iterator i = research.begin(); i != research.end(); ++i)
 	{
-		for (std::vector<std::string>::iterator j = matches.begin(); j != matches.end(); ++j)
-		{
-			if ((*i)->getName() == *j)
-			{
-				j = matches.erase(j);
-				break;
-			}
-		}
-		if (matches.empty())
-			return true;
+		if (!isResearched(*i, false))
+			return false;
 	}
 
-	return false;
+	return true;
+}
+
+/**
+ * Returns if a certain list of research topics has been completed.
+ * @param research List of research rules, null entries are never researched.
+ * @param considerDebugMode Should debug mode be considered or not.
+ * @return Whether it's researched or not.
+ */
+bool SavedGame::isResearched(const std::vector<const RuleResearch *> &research, bool considerDebugMode) const
+{
+	if (considerDebugMode && _debug)
+		return true;
+	for (std::vector<const RuleResearch *>::const_iterator i = research.begin(); i != research.end(); ++i)
+	{
+		if (*i == 0 || !isResearched(*i, false))
+			return false;
+	}
+
+	return true;
 }
 
 /**
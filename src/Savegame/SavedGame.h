@@ -119,6 +119,7 @@ private:
 	AlienStrategy *_alienStrategy;
 	SavedBattleGame *_battleGame;
 	std::vector<const RuleResearch*> _discovered;
+	std::vector<bool> _researched; // indexed by research handle, mirrors _discovered
 	std::vector<AlienMission*> _activeMissions;
 	bool _debug, _warned;
 	int _monthsPassed;
@@ -132,6 +133,8 @@ private:
 	std::vector<MissionStatistics*> _missionStatistics;
 
 	static SaveInfo getSaveInfo(const std::string &file, Language *lang);
+	/// Adds a research topic to the discovered list.
+	void addDiscovered(const RuleResearch *research);
 public:
 	static const std::string AUTOSAVE_GEOSCAPE, AUTOSAVE_BATTLESCAPE, QUICKSAVE;
 	/// Creates a new saved game.
@@ -234,8 +237,12 @@ public:
 	bool hasUndiscoveredProtectedUnlock(const RuleResearch * r, const Mod * mod) const;
 	/// Gets if a certain research has been completed.
 	bool isResearched(const std::string &research, bool considerDebugMode = true) const;
+	/// Gets if a certain research has been completed.
+	bool isResearched(const RuleResearch *research, bool considerDebugMode = true) const;
 	/// Gets if a certain list of research topics has been completed.
 	bool isResearched(const std::vector<std::string> &research, bool considerDebugMode = true) const;
+	/// Gets if a certain list of research topics has been completed.
+	bool isResearched(const std::vector<const RuleResearch*> &research, bool considerDebugMode = true) const;
 	/// Gets the soldier matching this ID.
 	Soldier *getSoldier(int id) const;
 	/// Handles the higher promotions.
@@ -45,11 +45,15 @@ Tile::SerializationKey Tile::serializationKey =
  4 + 2*4 + 2*4 + 1 + 1 + 1 // total bytes to save one tile
 };
 
+unsigned int Tile::_geometryRevision = 0;
+unsigned int Tile::_terrainRevision = 0;
+
 /**
  * constructor
  * @param pos Position.
+ * @param activeTiles List the tile adds itself to while it has fire, smoke or danger.
  */
-Tile::Tile(Position pos): _smoke(0), _fire(0), _explosive(0), _explosiveType(0), _pos(pos), _unit(0), _animationOffset(0), _markerColor(0), _visible(false), _preview(-1), _TUMarker(-1), _overlaps(0), _danger(false), _obstacle(0)
+Tile::Tile(Position pos, std::vector<Tile*> *activeTiles): _smoke(0), _fire(0), _explosive(0), _explosiveType(0), _pos(pos), _unit(0), _animationOffset(0), _markerColor(0), _visible(false), _preview(-1), _TUMarker(-1), _overlaps(0), _danger(false), _obstacle(0), _activeTiles(activeTiles), _active(false), _lastChange(0), _lastTerrainChange(0)
 {
 	for (int i = 0; i < 4; ++i)
 	{
@@ -114,6 +118,7 @@ void Tile::load(const YAML::Node &node)
 	if (_fire || _smoke)
 	{
 		_animationOffset = std::rand() % 4;
+		activate();
 	}
 }
 
@@ -145,6 +150,7 @@ void Tile::loadBinary(Uint8 *buffer, Tile::SerializationKey& serKey)
 	if (_fire || _smoke)
 	{
 		_animationOffset = std::rand() % 4;
+		activate();
 	}
 }
 
@@ -220,6 +226,7 @@ void Tile::setMapData(MapData *dat, int mapDataID, int mapDataSetID, TilePart pa
 	_objects[part] = dat;
 	_mapDataID[part] = mapDataID;
 	_mapDataSetID[part] = mapDataSetID;
+	touch(true);
 }
 
 /**
@@ -357,6 +364,7 @@ int Tile::openDoor(TilePart part, BattleUnit *unit, BattleActionType reserve)
 		if (unit &&	unit->getTimeUnits() < _objects[part]->getTUCost(unit->getMovementType()) + unit->getActionTUs(reserve, unit->getMainHandWeapon(false)))
 			return 4;
 		_currentFrame[part] = 1; // start opening door
+		touch(true);
 		return 1;
 	}
 	if (_objects[part]->isUFODoor() && _currentFrame[part] != 7) // ufo door != part 7 - door is still opening
@@ -376,6 +384,7 @@ int Tile::closeUfoDoor()
 		{
 			_currentFrame[part] = 0;
 			retval = 1;
+			touch(true);
 		}
 	}
 
@@ -612,7 +621,9 @@ void Tile::ignite(int power)
 				_smoke = 15 - Clamp(getFlammability() / 10, 1, 12);
 				_overlaps = 1;
 				_fire = getFuel() + 1;
-				_animationOffset = RNG::generate(0,3);
+				_animationOffset = RNG::getStream(RNG::STREAM_COSMETIC).generate(0,3);
+				activate();
+				touch();
 			}
 		}
 	}
@@ -644,6 +655,10 @@ void Tile::animate()
 				newframe = 0;
 			}
 			_currentFrame[i] = newframe;
+			if (_objects[i]->isUFODoor())
+			{
+				touch(true); // opening doors get cheaper to walk through
+			}
 		}
 	}
 	for (std::list<Particle*>::iterator i = _particles.begin(); i != _particles.end();)
@@ -685,6 +700,7 @@ void Tile::setUnit(BattleUnit *unit, Tile *tileBelow)
 		unit->setTile(this, tileBelow);
 	}
 	_unit = unit;
+	touch();
 }
 
 /**
@@ -694,7 +710,12 @@ void Tile::setUnit(BattleUnit *unit, Tile *tileBelow)
 void Tile::setFire(int fire)
 {
 	_fire = fire;
-	_animationOffset = RNG::generate(0,3);
+	touch();
+	_animationOffset = RNG::getStream(RNG::STREAM_COSMETIC).generate(0,3);
+	if (_fire)
+	{
+		activate();
+	}
 }
 
 /**
@@ -722,8 +743,13 @@ void Tile::addSmoke(int smoke)
 		{
 			_smoke += smoke;
 		}
-		_animationOffset = RNG::generate(0,3);
+		_animationOffset = RNG::getStream(RNG::STREAM_COSMETIC).generate(0,3);
 		addOverlap();
+		touch();
+		if (_smoke)
+		{
+			activate();
+		}
 	}
 }
 
@@ -734,7 +760,12 @@ void Tile::addSmoke(int smoke)
 void Tile::setSmoke(int smoke)
 {
 	_smoke = smoke;
-	_animationOffset = RNG::generate(0,3);
+	touch();
+	_animationOffset = RNG::getStream(RNG::STREAM_COSMETIC).generate(0,3);
+	if (_smoke)
+	{
+		activate();
+	}
 }
 
 
@@ -816,6 +847,7 @@ void Tile::prepareNewTurn(bool smokeDamage)
 	if ( _overlaps != 0 && _smoke != 0 && _fire == 0)
 	{
 		_smoke = Clamp((_smoke / _overlaps) - 1, 0, 15);
+		touch();
 	}
 	// if we still have smoke/fire
 	if (_smoke)
@@ -965,6 +997,10 @@ void Tile::addOverlap()
 void Tile::setDangerous(bool danger)
 {
 	_danger = danger;
+	if (_danger)
+	{
+		activate();
+	}
 }
 
 /**
@@ -976,6 +1012,99 @@ bool Tile::getDangerous() const
 	return _danger;
 }
 
+/**
+ * Adds the tile to the battle's list of tiles with fire, smoke or danger,
+ * unless it's already on it.
+ */
+void Tile::activate()
+{
+	if (!_active && _activeTiles)
+	{
+		_activeTiles->push_back(this);
+		_active = true;
+	}
+}
+
+/**
+ * check if this tile still needs to be on the active tile list.
+ * @return true if the tile has fire, smoke or the danger flag.
+ */
+bool Tile::isActive() const
+{
+	return _fire != 0 || _smoke != 0 || _danger;
+}
+
+/**
+ * marks the tile as taken off the active tile list,
+ * so it can add itself again when it catches fire or smoke.
+ */
+void Tile::deactivate()
+{
+	_active = false;
+}
+
+/**
+ * Gets the revision number of the terrain and unit layout,
+ * which goes up every time something that blocks lines of sight or movement changes.
+ * @return The revision number.
+ */
+unsigned int Tile::getGeometryRevision()
+{
+	return _geometryRevision;
+}
+
+/**
+ * Gets the geometry revision at which this tile last changed
+ * its terrain, doors, occupant, fire or smoke.
+ * @return The revision number.
+ */
+unsigned int Tile::getLastChange() const
+{
+	return _lastChange;
+}
+
+/**
+ * Gets the geometry revision of the last change to terrain or doors anywhere on the map.
+ * @return The revision number.
+ */
+unsigned int Tile::getTerrainRevision()
+{
+	return _terrainRevision;
+}
+
+/**
+ * Gets the geometry revision at which this tile last changed its terrain or doors.
+ * @return The revision number.
+ */
+unsigned int Tile::getLastTerrainChange() const
+{
+	return _lastTerrainChange;
+}
+
+/**
+ * Marks the terrain or unit layout as changed,
+ * so cached lines of sight get recalculated.
+ */
+void Tile::touchGeometry()
+{
+	++_geometryRevision;
+}
+
+/**
+ * Marks this tile as changed, stamping it with the new geometry revision
+ * so plans worked out around it know they are stale.
+ * @param terrain Did the terrain or a door change, rather than the occupant, fire or smoke?
+ */
+void Tile::touch(bool terrain)
+{
+	_lastChange = ++_geometryRevision;
+	if (terrain)
+	{
+		_lastTerrainChange = _lastChange;
+		_terrainRevision = _lastChange;
+	}
+}
+
 /**
  * adds a particle to this tile's internal storage buffer.
  * @param particle the particle to add.
@@ -80,9 +80,17 @@ protected:
 	bool _danger;
 	std::list<Particle*> _particles;
 	int _obstacle;
+	std::vector<Tile*> *_activeTiles;
+	bool _active;
+	unsigned int _lastChange, _lastTerrainChange;
+	static unsigned int _geometryRevision, _terrainRevision;
+	/// Adds the tile to the battle's active tile list.
+	void activate();
+	/// Stamps the tile with a new geometry revision.
+	void touch(bool terrain = false);
 public:
 	/// Creates a tile.
-	Tile(Position pos);
+	Tile(Position pos, std::vector<Tile*> *activeTiles = 0);
 	/// Cleans up a tile.
 	~Tile();
 	/// Load the tile from yaml
@@ -237,6 +245,20 @@ public:
 	void setDangerous(bool danger);
 	/// check the danger flag on this tile.
 	bool getDangerous() const;
+	/// check if this tile still has fire, smoke or danger.
+	bool isActive() const;
+	/// marks the tile as no longer being on the active tile list.
+	void deactivate();
+	/// gets the revision number of the terrain and unit layout.
+	static unsigned int getGeometryRevision();
+	/// gets the geometry revision this tile last changed at.
+	unsigned int getLastChange() const;
+	/// gets the geometry revision of the last terrain change anywhere.
+	static unsigned int getTerrainRevision();
+	/// gets the geometry revision this tile's terrain last changed at.
+	unsigned int getLastTerrainChange() const;
+	/// marks the terrain or unit layout as changed.
+	static void touchGeometry();
 	/// adds a particle to this tile's array.
 	void addParticle(Particle *particle);
 	/// gets a pointer to this tile's particle array.
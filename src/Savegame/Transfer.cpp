@@ -23,6 +23,7 @@
 #include "ItemContainer.h"
 #include "../Engine/Language.h"
 #include "../Mod/Mod.h"
+#include "../Mod/RuleItem.h"
 #include "../Engine/Logger.h"
 
 namespace OpenXcom
@@ -32,7 +33,7 @@ namespace OpenXcom
  * Initializes a transfer.
  * @param hours Hours in-transit.
  */
-Transfer::Transfer(int hours) : _hours(hours), _soldier(0), _craft(0), _itemQty(0), _scientists(0), _engineers(0), _delivered(false)
+Transfer::Transfer(int hours) : _hours(hours), _soldier(0), _craft(0), _itemRules(0), _itemQty(0), _scientists(0), _engineers(0), _delivered(false)
 {
 }
 
@@ -93,7 +94,8 @@ bool Transfer::load(const YAML::Node& node, Base *base, const Mod *mod, SavedGam
 	if (const YAML::Node &item = node["itemId"])
 	{
 		_itemId = item.as<std::string>(_itemId);
-		if (mod->getItem(_itemId) == 0)
+		_itemRules = mod->getItem(_itemId);
+		if (_itemRules == 0)
 		{
 			Log(LOG_ERROR) << "Failed to load item " << _itemId;
 			delete this;
@@ -179,14 +181,24 @@ std::string Transfer::getItems() const
 	return _itemId;
 }
 
+/**
+ * Returns the ruleset for the items being transferred.
+ * @return Pointer to the item ruleset.
+ */
+const RuleItem *Transfer::getItemRules() const
+{
+	return _itemRules;
+}
+
 /**
  * Changes the items being transferred.
- * @param id Item identifier.
+ * @param rules Item ruleset.
  * @param qty Item quantity.
  */
-void Transfer::setItems(const std::string &id, int qty)
+void Transfer::setItems(const RuleItem *rules, int qty)
 {
-	_itemId = id;
+	_itemId = rules->getType();
+	_itemRules = rules;
 	_itemQty = qty;
 }
 
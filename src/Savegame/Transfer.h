@@ -41,6 +41,7 @@ class Language;
 class Base;
 class Mod;
 class SavedGame;
+class RuleItem;
 
 /**
  * Represents an item transfer.
@@ -54,6 +55,7 @@ private:
 	Soldier *_soldier;
 	Craft *_craft;
 	std::string _itemId;
+	const RuleItem *_itemRules;
 	int _itemQty, _scientists, _engineers;
 	bool _delivered;
 public:
@@ -73,8 +75,10 @@ public:
 	Craft *getCraft();
 	/// Gets the items of the transfer.
 	std::string getItems() const;
+	/// Gets the ruleset for the items of the transfer.
+	const RuleItem *getItemRules() const;
 	/// Sets the items of the transfer.
-	void setItems(const std::string &id, int qty = 1);
+	void setItems(const RuleItem *rules, int qty = 1);
 	/// Sets the scientists of the transfer.
 	void setScientists(int scientists);
 	/// Sets the engineers of the transfer.
@@ -23,6 +23,7 @@
 #include "Engine/Game.h"
 #include "Engine/Options.h"
 #include "Menu/StartState.h"
+#include "Geoscape/CampaignSimulator.h"
 
 /** @mainpage
  * @author OpenXcom Developers
@@ -114,11 +115,32 @@ int main(int argc, char *argv[])
 		Logger::reportingLevel() = LOG_VERBOSE;
 	Options::baseXResolution = Options::displayWidth;
 	Options::baseYResolution = Options::displayHeight;
+	if (Options::getSimulateMonths() > 0 && Options::getSimulateRuns() > 1)
+	{
+		CampaignSimulator::runBatch(argc, argv, Options::getSimulateMonths(), Options::getSimulateSeed(), Options::getSimulateRuns(), Options::getSimulateJobs());
+		return EXIT_SUCCESS;
+	}
+	if (Options::getSimulateMonths() > 0)
+	{
+		// nobody is watching, keep the window and sound out of the way
+		SDL_putenv((char *)"SDL_VIDEODRIVER=dummy");
+		Options::mute = true;
+		Options::useOpenGL = false;
+		Options::fullscreen = false;
+	}
 
 	game = new Game(title.str());
 	State::setGamePtr(game);
-	game->setState(new StartState);
-	game->run();
+	if (Options::getSimulateMonths() > 0)
+	{
+		CampaignSimulator simulator(game);
+		simulator.run(Options::getSimulateMonths(), Options::getSimulateSeed());
+	}
+	else
+	{
+		game->setState(new StartState);
+		game->run();
+	}
 
 	// Comment this for faster exit.
 	delete game;